@@ -0,0 +1,151 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+using namespace std;
+
+// 스테이지/프레임 단위 bump 할당자
+// - allocate   : 현재 청크에서 포인터만 전진시킴 (O(1))
+// - deallocate : 개별 해제는 하지 않음
+// - reset      : 확보해 둔 청크를 그대로 두고 처음부터 다시 사용 (O(1))
+// 한 번 워밍업된 뒤에는 reset/allocate 반복 중에 힙 할당이 일어나지 않음
+// 청크는 upstream에서 받음 (nullptr이면 operator new)
+class Arena : public std::pmr::memory_resource
+{
+public:
+    explicit Arena(size_t initialChunkSize = 64 * 1024, std::pmr::memory_resource* upstream = nullptr);
+    ~Arena() override;
+
+    // 복사/이동 방지 (컨테이너들이 이 주소를 들고 있음)
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void reset();
+
+    size_t bytesUsed() const { return usedBytes; }
+    size_t bytesReserved() const { return reservedBytes; }
+    size_t chunkCount() const { return chunks; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    struct Chunk
+    {
+        Chunk* next;
+        size_t size;
+
+        std::byte* data() { return reinterpret_cast<std::byte*>(this + 1); }
+    };
+
+    std::pmr::memory_resource* upstream;
+    Chunk* head = nullptr;
+    Chunk* tail = nullptr;
+    Chunk* current = nullptr;
+    size_t offset = 0;
+    size_t nextChunkSize;
+    size_t usedBytes = 0;
+    size_t reservedBytes = 0;
+    size_t chunks = 0;
+
+    Chunk* appendChunk(size_t minSize);
+    void* allocateFrom(Chunk* chunk, size_t bytes, size_t alignment);
+};
+
+Arena::Arena(size_t initialChunkSize, std::pmr::memory_resource* upstream)
+    : upstream(upstream), nextChunkSize(initialChunkSize > 0 ? initialChunkSize : 1024)
+{
+    current = appendChunk(nextChunkSize);
+}
+
+Arena::~Arena()
+{
+    Chunk* chunk = head;
+    while (chunk) {
+        Chunk* next = chunk->next;
+        if (upstream) {
+            upstream->deallocate(chunk, sizeof(Chunk) + chunk->size, alignof(std::max_align_t));
+        } else {
+            ::operator delete(chunk);
+        }
+        chunk = next;
+    }
+}
+
+void Arena::reset()
+{
+    // 청크 목록은 유지하고 커서만 되돌림
+    current = head;
+    offset = 0;
+    usedBytes = 0;
+}
+
+void* Arena::allocateFrom(Chunk* chunk, size_t bytes, size_t alignment)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(chunk->data());
+    uintptr_t start = (base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    size_t end = static_cast<size_t>(start - base) + bytes;
+    if (end > chunk->size) {
+        return nullptr;
+    }
+    offset = end;
+    usedBytes += bytes;
+    return reinterpret_cast<void*>(start);
+}
+
+Arena::Chunk* Arena::appendChunk(size_t minSize)
+{
+    size_t size = nextChunkSize;
+    while (size < minSize) {
+        size *= 2;
+    }
+    // upstream이 없으면 operator new 경유 (계측 빌드의 할당 카운터에 잡히도록)
+    void* memory = upstream ? upstream->allocate(sizeof(Chunk) + size, alignof(std::max_align_t))
+                            : ::operator new(sizeof(Chunk) + size);
+    Chunk* chunk = static_cast<Chunk*>(memory);
+    chunk->next = nullptr;
+    chunk->size = size;
+    if (tail) {
+        tail->next = chunk;
+    } else {
+        head = chunk;
+    }
+    tail = chunk;
+    reservedBytes += size;
+    chunks++;
+    // 다음 청크는 두 배로 키워 청크 수를 로그 수준으로 유지
+    nextChunkSize = size * 2;
+    return chunk;
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment)
+{
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    if (void* p = allocateFrom(current, bytes, alignment)) {
+        return p;
+    }
+    // reset 이후라면 이미 확보해 둔 다음 청크들부터 재사용
+    while (current->next) {
+        current = current->next;
+        offset = 0;
+        if (void* p = allocateFrom(current, bytes, alignment)) {
+            return p;
+        }
+    }
+    current = appendChunk(bytes + alignment);
+    offset = 0;
+    return allocateFrom(current, bytes, alignment);
+}
+
+#endif
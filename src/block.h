@@ -2,6 +2,7 @@
 #define BLOCK_H
 #include <iostream>
 #include <vector>
+#include <memory_resource>
 #include <stdexcept>
 
 using namespace std;
@@ -159,13 +160,20 @@ public:
 class SnakeHead : public Block
 {
 public:
-    vector<SnakeBody> snakeBodySegments;
+    std::pmr::vector<SnakeBody> snakeBodySegments;
     int currentDirection = -1;
     
     friend class SnakeBody;
     
     SnakeHead() : Block() { objectType = 3; }
     SnakeHead(int row, int col) : Block(row, col) { objectType = 3; }
+    // 몸통 벡터를 지정한 메모리 리소스(스테이지 아레나 등)에 할당
+    explicit SnakeHead(std::pmr::memory_resource* resource)
+        : Block(), snakeBodySegments(resource) { objectType = 3; }
+    // 다른 메모리 리소스로 복사 (캐시된 스테이지 레이아웃 복원용)
+    SnakeHead(const SnakeHead& other, std::pmr::memory_resource* resource)
+        : Block(other), snakeBodySegments(other.snakeBodySegments, resource),
+          currentDirection(other.currentDirection) {}
     
     int getObjectType() const override { return objectType; }
     
@@ -0,0 +1,204 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include <ncurses.h>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include "map.h"
+#include "mission.h"
+#include "reachability.h"
+
+using namespace std;
+
+// 헤드리스 모드용 자동 조종
+// 점유 격자만 보고 한 칸 앞을 판단: 막힌 칸 회피 → 막다른 길 회피 → 목표(아이템·게이트) 쪽 선호
+// 연결 요소 정보를 주면 몸 길이보다 좁은 공간(들어가면 갇힘)으로 들어가는 방향을 피함
+// 미션 진행을 주면 남은 목표에 맞춰 Growth → Poison → Time → Gate 순으로 노림 (없으면 늘 Growth)
+class AutoPilot
+{
+public:
+    explicit AutoPilot(unsigned int seed = 1) : rng(seed) {}
+
+    // 이번 틱에 넣을 키 (방향 유지면 ERR)
+    int nextKey(const Map& map, const ReachabilityMap* reachability = nullptr, const MissionTracker* missions = nullptr);
+
+private:
+    std::mt19937 rng;
+
+    static bool isPassable(Cell cell, size_t bodySize);
+    static Coord step(const Coord& pos, int direction);
+    static int keyFor(int direction);
+    // 남은 미션 목표로 정한 이번 목표 칸 종류 (GROWTH/POISON/TIME/GATE)
+    static Cell wantedTarget(const MissionTracker* missions);
+    // gate 칸에 direction으로 들어가면 나오는 칸과 방향 (Game::update의 진출 규칙과 같음, 알 수 없으면 false)
+    static bool gateExit(const Map& map, const Coord& gate, int direction, Coord& exit, int& exitDirection);
+};
+
+bool AutoPilot::isPassable(Cell cell, size_t bodySize)
+{
+    switch (cell) {
+        case Cell::EMPTY:
+        case Cell::GROWTH:
+        case Cell::TIME:
+        case Cell::GATE:        // 실제로 들어갈지는 nextKey가 나오는 칸을 보고 정함
+            return true;
+        case Cell::POISON:
+            // 길이 3 미만이 되면 Game Over이므로 여유가 있을 때만
+            return bodySize > 4;
+        default:
+            return false;
+    }
+}
+
+Coord AutoPilot::step(const Coord& pos, int direction)
+{
+    Coord next = pos;
+    switch (direction) {
+        case 1: next.row--; break;
+        case 2: next.col--; break;
+        case 3: next.col++; break;
+        case 4: next.row++; break;
+    }
+    return next;
+}
+
+int AutoPilot::keyFor(int direction)
+{
+    switch (direction) {
+        case 1: return KEY_UP;
+        case 2: return KEY_LEFT;
+        case 3: return KEY_RIGHT;
+        case 4: return KEY_DOWN;
+    }
+    return ERR;
+}
+
+Cell AutoPilot::wantedTarget(const MissionTracker* missions)
+{
+    if (!missions) return Cell::GROWTH;
+    // metric별로 아직 모자란 양 (목표가 여럿이면 가장 큰 것, 목표가 없으면 0)
+    int need[static_cast<size_t>(MissionMetric::COUNT)] = {};
+    bool hasLengthGoal = false;
+    for (size_t i = 0; i < missions->goalCount(); ++i) {
+        const MissionGoal& goal = missions->goal(i);
+        int missing = goal.target - missions->value(goal.metric);
+        size_t slot = static_cast<size_t>(goal.metric);
+        if (goal.metric == MissionMetric::SNAKE_LENGTH) {
+            // 길이는 남는 만큼도 셈 (Poison을 먹으면 줄어드므로)
+            need[slot] = hasLengthGoal ? std::max(need[slot], missing) : missing;
+            hasLengthGoal = true;
+        } else {
+            need[slot] = std::max(need[slot], missing);
+        }
+    }
+    int poisonNeed = need[static_cast<size_t>(MissionMetric::POISON_ITEMS)];
+    if (need[static_cast<size_t>(MissionMetric::GROWTH_ITEMS)] > 0
+        || (hasLengthGoal && need[static_cast<size_t>(MissionMetric::SNAKE_LENGTH)] + poisonNeed > 0)) {
+        return Cell::GROWTH;
+    }
+    if (poisonNeed > 0) return Cell::POISON;
+    if (need[static_cast<size_t>(MissionMetric::TIME_ITEMS)] > 0) return Cell::TIME;
+    if (need[static_cast<size_t>(MissionMetric::GATES_USED)] > 0) return Cell::GATE;
+    return Cell::GROWTH;
+}
+
+bool AutoPilot::gateExit(const Map& map, const Coord& gate, int direction, Coord& exit, int& exitDirection)
+{
+    if (map.gameGates.size() < 2) return false;
+    const Gate& other = map.gameGates[0].coord == gate ? map.gameGates[1] : map.gameGates[0];
+    exitDirection = other.exitDirection;
+    if (exitDirection == 6) {
+        // 진입 방향 → 반시계 → 시계 → 반대 순으로 벽이 아닌 첫 방향
+        static const int PRIORITY[5][4] = {{0}, {1, 2, 3, 4}, {2, 4, 1, 3}, {3, 1, 4, 2}, {4, 3, 2, 1}};
+        if (direction < 1 || direction > 4) return false;
+        exitDirection = -1;
+        for (int d : PRIORITY[direction]) {
+            Coord pos = step(other.coord, d);
+            if (!map.occupancy.inBounds(pos)) continue;
+            Cell ground = map.occupancy.groundAt(pos);
+            if (ground != Cell::WALL && ground != Cell::GATE) {
+                exitDirection = d;
+                break;
+            }
+        }
+    }
+    if (exitDirection < 1 || exitDirection > 4) return false;
+    exit = step(other.coord, exitDirection);
+    return map.occupancy.inBounds(exit);
+}
+
+int AutoPilot::nextKey(const Map& map, const ReachabilityMap* reachability, const MissionTracker* missions)
+{
+    const SnakeHead& head = map.snakeHeadObject;
+    size_t bodySize = head.snakeBodySegments.size();
+    int current = head.currentDirection;
+    int opposite = (current >= 1 && current <= 4) ? 5 - current : -1;
+    // 가장 가까운 목표 칸 (놓인 아이템만, 없으면 Growth로 대신)
+    Cell wanted = wantedTarget(missions);
+    Coord target = head.coord;
+    int nearest = -1;
+    auto consider = [&](const Coord& pos) {
+        int d = abs(pos.row - head.coord.row) + abs(pos.col - head.coord.col);
+        if (nearest == -1 || d < nearest) {
+            nearest = d;
+            target = pos;
+        }
+    };
+    if (wanted == Cell::GATE) {
+        for (const Gate& gate : map.gameGates) {
+            if (map.occupancy.inBounds(gate.coord) && map.occupancy.groundAt(gate.coord) == Cell::GATE) consider(gate.coord);
+        }
+    } else {
+        for (Cell kind : {wanted, Cell::GROWTH}) {
+            for (size_t i = 0; i < map.itemCount(kind); ++i) {
+                const Coord& pos = map.itemCoord(kind, i);
+                if (map.occupancy.inBounds(pos) && map.occupancy.groundAt(pos) == kind) consider(pos);
+            }
+            if (nearest != -1) break;
+        }
+    }
+
+    int bestDirection = -1;
+    int bestScore = 0;
+    for (int direction = 1; direction <= 4; ++direction) {
+        if (direction == opposite) continue;
+        Coord next = step(head.coord, direction);
+        Cell cell = map.occupancy.at(next);
+        if (!isPassable(cell, bodySize)) continue;
+        // 게이트는 반대편으로 나온 칸을 기준으로 판단 (나오자마자 막혀 있으면 들어가지 않음)
+        Coord landing = next;
+        bool throughGate = false;
+        if (cell == Cell::GATE) {
+            int exitDirection;
+            if (!gateExit(map, next, direction, landing, exitDirection)) continue;
+            Cell exitCell = map.occupancy.at(landing);
+            if (exitCell == Cell::GATE || !isPassable(exitCell, bodySize)) continue;
+            throughGate = true;
+        }
+
+        // 다음 칸에서 다시 나갈 수 있는 방향 수 (막다른 길 회피)
+        int exits = 0;
+        for (int d = 1; d <= 4; ++d) {
+            if (isPassable(map.occupancy.at(step(landing, d)), bodySize)) exits++;
+        }
+        int distance = (wanted == Cell::GATE && throughGate) ? 0
+                     : abs(landing.row - target.row) + abs(landing.col - target.col);
+        int score = exits * 1000 - distance * 10 + static_cast<int>(rng() % 10);
+        if (direction == current) score += 5;
+        if (reachability && reachability->componentSize(reachability->label(landing)) < static_cast<int>(bodySize)) {
+            score -= 5000;
+        }
+        if (bestDirection == -1 || score > bestScore) {
+            bestDirection = direction;
+            bestScore = score;
+        }
+    }
+
+    if (bestDirection == -1 || bestDirection == current) {
+        return ERR;
+    }
+    return keyFor(bestDirection);
+}
+
+#endif
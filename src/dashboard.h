@@ -0,0 +1,146 @@
+#ifndef DASHBOARD_H
+#define DASHBOARD_H
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <ncurses.h>
+#include "grid.h"
+#include "frame.h"
+#include "renderer.h"
+
+using namespace std;
+
+// 여러 게임 보드를 한 터미널에 타일로 나란히 그리는 대시보드 (ncurses 초기화 뒤 생성)
+// - 타일 = 보드(점유 격자 크기) + 아래 점수 한 줄, 터미널에 들어가는 만큼만 배치
+// - 타일마다 직전에 그린 칸을 기억해 바뀐 칸만 다시 씀 → ncurses가 내보내는 것도 바뀐 칸뿐
+// - 모든 타일은 wnoutrefresh로 모았다가 present()에서 doupdate() 한 번
+// 글자는 헤드리스 스트리밍과 같음 (FrameSerializer::glyphFor), 색은 NcursesInitializer의 1=초록 2=노랑 3=빨강
+class Dashboard
+{
+public:
+    // 타일 한 줄 점수에 쓰는 값
+    struct TileStatus
+    {
+        int stage = 1;
+        int length = 0;
+        int maxLength = 0;
+        long deaths = 0;
+        long clears = 0;
+    };
+
+    static constexpr int MIN_TILE_WIDTH = 20;   // 점수 줄이 들어갈 최소 폭
+    static constexpr int HEADER_ROWS = 1;
+
+    // gridRows x gridCols 격자를 gameCount개까지 배치. 타일이 하나도 안 들어가면 runtime_error
+    Dashboard(int gridRows, int gridCols, size_t gameCount);
+
+    Dashboard(const Dashboard&) = delete;
+    Dashboard& operator=(const Dashboard&) = delete;
+
+    // 화면에 들어간 타일 수 (게임 수보다 적을 수 있음)
+    size_t tileCount() const { return tiles.size(); }
+
+    void drawHeader(const char* text);
+    void drawTile(size_t index, const OccupancyGrid& grid, const TileStatus& status);
+    // 모은 변경을 터미널에 한 번에 출력
+    void present();
+
+private:
+    static constexpr Cell NOT_DRAWN = static_cast<Cell>(0xFF);
+
+    struct Tile
+    {
+        WindowWrapper window;
+        std::vector<Cell> shown;    // 직전에 그린 칸 (NOT_DRAWN이면 아직 안 그림)
+        char status[64];
+    };
+
+    int gridRows, gridCols;
+    std::vector<Tile> tiles;
+
+    static chtype glyph(Cell cell);
+};
+
+Dashboard::Dashboard(int gridRows, int gridCols, size_t gameCount)
+    : gridRows(gridRows), gridCols(gridCols)
+{
+    int termRows, termCols;
+    getmaxyx(stdscr, termRows, termCols);
+    int tileHeight = gridRows + 1;
+    int tileWidth = std::max(gridCols, MIN_TILE_WIDTH);
+    // 타일 사이는 한 칸씩 띄움
+    int across = (termCols + 1) / (tileWidth + 1);
+    int down = (termRows - HEADER_ROWS + 1) / (tileHeight + 1);
+    if (across < 1 || down < 1) {
+        throw std::runtime_error("Terminal too small for one " + std::to_string(tileWidth) + "x" +
+                                 std::to_string(tileHeight) + " tile");
+    }
+    size_t count = std::min(gameCount, (size_t)across * down);
+    tiles.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        int row = HEADER_ROWS + (int)(i / across) * (tileHeight + 1);
+        int col = (int)(i % across) * (tileWidth + 1);
+        tiles.push_back(Tile{WindowWrapper(tileHeight, tileWidth, row, col),
+                             std::vector<Cell>((size_t)gridRows * gridCols, NOT_DRAWN), ""});
+    }
+}
+
+chtype Dashboard::glyph(Cell cell)
+{
+    chtype ch = (chtype)FrameSerializer::glyphFor(cell);
+    switch (cell) {
+        case Cell::HEAD:        return ch | A_BOLD | COLOR_PAIR(2);
+        case Cell::BODY:        return ch | COLOR_PAIR(1);
+        case Cell::GROWTH:      return ch | A_BOLD | COLOR_PAIR(1);
+        case Cell::POISON:      return ch | A_BOLD | COLOR_PAIR(3);
+        case Cell::TIME:        return ch | A_BOLD | COLOR_PAIR(2);
+        case Cell::GATE:        return ch | A_REVERSE | COLOR_PAIR(2);
+        case Cell::WALL:
+        case Cell::IMMUNE_WALL: return ch | A_DIM;
+        default:                return ch;
+    }
+}
+
+void Dashboard::drawHeader(const char* text)
+{
+    mvwaddnstr(stdscr, 0, 0, text, COLS);
+    wclrtoeol(stdscr);
+    wnoutrefresh(stdscr);
+}
+
+void Dashboard::drawTile(size_t index, const OccupancyGrid& grid, const TileStatus& status)
+{
+    Tile& tile = tiles.at(index);
+    WINDOW* window = tile.window.get();
+    int rows = std::min(grid.rows(), gridRows);
+    int cols = std::min(grid.cols(), gridCols);
+    const Cell* cells = grid.data();
+    for (int row = 0; row < rows; ++row) {
+        const Cell* source = cells + (size_t)row * grid.cols();
+        Cell* shown = tile.shown.data() + (size_t)row * gridCols;
+        for (int col = 0; col < cols; ++col) {
+            if (source[col] == shown[col]) continue;
+            shown[col] = source[col];
+            mvwaddch(window, row, col, glyph(source[col]));
+        }
+    }
+    char line[sizeof(tile.status)];
+    std::snprintf(line, sizeof(line), "#%zu S%d L%d/%d D%ld C%ld", index + 1, status.stage,
+                  status.length, status.maxLength, status.deaths, status.clears);
+    if (std::strcmp(line, tile.status) != 0) {
+        std::memcpy(tile.status, line, sizeof(line));
+        mvwaddnstr(window, gridRows, 0, line, getmaxx(window));
+        wclrtoeol(window);
+    }
+    wnoutrefresh(window);
+}
+
+void Dashboard::present()
+{
+    doupdate();
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "block.h"
+#include "grid.h"
+
+using namespace std;
+
+// 시뮬레이션이 한 틱 동안 만들어내는 사건
+// update()는 상태를 바꾸고 사건만 남기며, 점수·미션·소리·관전 등은 구독자가 처리
+enum class EventType : uint8_t {
+    HEAD_MOVED,         // 머리가 pos로 이동
+    TAIL_VACATED,       // 꼬리가 pos를 비움
+    CELL_CHANGED,       // 그 밖의 칸 표시 변경 (이전 머리 → 몸통, 꼬리 연장 등)
+    ITEM_SPAWNED,       // 아이템이 pos에 생성
+    ITEM_CONSUMED,      // 머리가 pos의 아이템을 먹음
+    GATE_ENTERED,       // 머리가 pos의 게이트로 들어감
+    MISSION_PROGRESS,   // 미션 달성 상태 변경
+    GAME_OVER
+};
+
+enum class ItemKind : uint8_t {
+    GROWTH,
+    POISON,
+    TIME
+};
+
+// Game Over 원인
+enum class DeathReason : uint8_t {
+    NONE,
+    OPPOSITE_DIRECTION,
+    WALL,
+    BODY_IN_WALL,
+    SELF,
+    TOO_SHORT
+};
+
+inline const char* describe(DeathReason reason)
+{
+    switch (reason) {
+        case DeathReason::OPPOSITE_DIRECTION: return "Tried moving in the opposite direction.";
+        case DeathReason::WALL:               return "Collided with the wall.";
+        case DeathReason::BODY_IN_WALL:       return "Snake body overlapped with wall.";
+        case DeathReason::SELF:               return "Collided with the body.";
+        case DeathReason::TOO_SHORT:          return "Length is less than 3.";
+        default:                              return "";
+    }
+}
+
+// 사건 하나 (trivially copyable, 고정 크기 버퍼에 그대로 쌓음)
+struct GameEvent
+{
+    EventType type;
+    Cell cell = Cell::EMPTY;            // 사건 직후 pos 칸의 표시 값
+    ItemKind item = ItemKind::GROWTH;   // ITEM_SPAWNED / ITEM_CONSUMED
+    DeathReason reason = DeathReason::NONE;     // GAME_OVER
+    uint16_t mission = 0;               // MISSION_PROGRESS: 미션 번호
+    bool achieved = false;              // MISSION_PROGRESS: 달성 여부
+    Coord pos{0, 0};
+
+    static GameEvent forCell(EventType type, const Coord& pos, Cell cell)
+    {
+        GameEvent event{type};
+        event.pos = pos;
+        event.cell = cell;
+        return event;
+    }
+    static GameEvent forItem(EventType type, ItemKind kind, const Coord& pos, Cell cell)
+    {
+        GameEvent event = forCell(type, pos, cell);
+        event.item = kind;
+        return event;
+    }
+    static GameEvent forMission(uint16_t mission, bool achieved)
+    {
+        GameEvent event{EventType::MISSION_PROGRESS};
+        event.mission = mission;
+        event.achieved = achieved;
+        return event;
+    }
+    static GameEvent forGameOver(DeathReason reason)
+    {
+        GameEvent event{EventType::GAME_OVER};
+        event.reason = reason;
+        return event;
+    }
+};
+
+// 사건 구독자
+class GameEventSink
+{
+public:
+    virtual ~GameEventSink() = default;
+    virtual void onEvent(const GameEvent& event) = 0;
+};
+
+// 한 틱 분량의 사건을 모아두었다가 dispatch()에서 구독자에게 순서대로 전달
+// 버퍼는 고정 크기 (틱 중 할당 없음). 가득 차면 그 자리에서 먼저 전달하고 비움
+// 구독자가 전달 중에 emit()한 사건도 같은 dispatch() 안에서 이어서 전달됨
+class EventQueue
+{
+public:
+    static const size_t CAPACITY = 256;
+    static const size_t MAX_SINKS = 8;
+
+    void subscribe(GameEventSink* sink);
+    void unsubscribe(GameEventSink* sink);
+
+    void emit(const GameEvent& event);
+    void dispatch();
+
+private:
+    GameEvent events[CAPACITY];
+    size_t count = 0;
+    GameEventSink* sinks[MAX_SINKS];
+    size_t sinkCount = 0;
+    bool dispatching = false;
+};
+
+void EventQueue::subscribe(GameEventSink* sink)
+{
+    for (size_t i = 0; i < sinkCount; ++i) {
+        if (sinks[i] == sink) return;
+    }
+    if (sinkCount == MAX_SINKS) {
+        throw std::length_error("Too many event subscribers");
+    }
+    sinks[sinkCount++] = sink;
+}
+
+void EventQueue::unsubscribe(GameEventSink* sink)
+{
+    for (size_t i = 0; i < sinkCount; ++i) {
+        if (sinks[i] == sink) {
+            for (size_t j = i + 1; j < sinkCount; ++j) sinks[j - 1] = sinks[j];
+            sinkCount--;
+            return;
+        }
+    }
+}
+
+void EventQueue::emit(const GameEvent& event)
+{
+    if (count == CAPACITY) {
+        // 전달 중에 넘치면 더 쌓을 곳이 없으므로 버림
+        if (dispatching) return;
+        dispatch();
+    }
+    events[count++] = event;
+}
+
+void EventQueue::dispatch()
+{
+    if (dispatching) return;
+    dispatching = true;
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t s = 0; s < sinkCount; ++s) {
+            sinks[s]->onEvent(events[i]);
+        }
+    }
+    count = 0;
+    dispatching = false;
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include "grid.h"
+
+using namespace std;
+
+// 점유 격자 → 텍스트 프레임 직렬화기 (헤드리스 스트리밍용)
+// - renderFull : 보드 전체를 한 프레임으로 (행마다 '\n')
+// - renderDiff : 직전 프레임과 달라진 칸만 ANSI 커서 이동 + 문자로
+// 버퍼는 보드 크기가 바뀔 때만 다시 확보하고, write()는 프레임당 한 번
+class FrameSerializer
+{
+public:
+    static char glyphFor(Cell cell);
+
+    // homeCursor: 프레임 앞에 커서를 좌상단으로 옮기는 시퀀스를 붙임 (터미널 재생용)
+    size_t renderFull(const OccupancyGrid& grid, bool homeCursor = false);
+    size_t renderDiff(const OccupancyGrid& grid);
+    // 다음 renderDiff가 전체를 다시 그리도록 이전 프레임을 버림
+    void invalidate() { previous.clear(); }
+
+    const char* buffer() const { return out.data(); }
+    size_t size() const { return length; }
+    // 직렬화된 프레임을 fd로 출력 (부분 쓰기는 이어서 재시도)
+    bool writeTo(int fd) const;
+
+private:
+    std::vector<char> out;
+    std::vector<char> previous;
+    size_t length = 0;
+    int previousRows = 0, previousCols = 0;
+
+    void ensureCapacity(size_t bytes);
+    char* appendNumber(char* p, int value);
+};
+
+char FrameSerializer::glyphFor(Cell cell)
+{
+    switch (cell) {
+        case Cell::EMPTY:       return ' ';
+        case Cell::BORDER:      return '#';
+        case Cell::WALL:        return 'W';
+        case Cell::IMMUNE_WALL: return 'I';
+        case Cell::GATE:        return 'G';
+        case Cell::HEAD:        return 'H';
+        case Cell::BODY:        return 'B';
+        case Cell::GROWTH:      return '+';
+        case Cell::POISON:      return '-';
+        case Cell::TIME:        return 'T';
+    }
+    return '?';
+}
+
+void FrameSerializer::ensureCapacity(size_t bytes)
+{
+    if (out.size() < bytes) {
+        out.resize(bytes);
+    }
+}
+
+char* FrameSerializer::appendNumber(char* p, int value)
+{
+    char digits[12];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+    return p;
+}
+
+size_t FrameSerializer::renderFull(const OccupancyGrid& grid, bool homeCursor)
+{
+    int rows = grid.rows();
+    int cols = grid.cols();
+    ensureCapacity((size_t)rows * (cols + 1) + 8);
+
+    char* p = out.data();
+    if (homeCursor) {
+        std::memcpy(p, "\x1b[H", 3);
+        p += 3;
+    }
+    const Cell* cells = grid.data();
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            *p++ = glyphFor(cells[(size_t)i * cols + j]);
+        }
+        *p++ = '\n';
+    }
+    length = static_cast<size_t>(p - out.data());
+
+    // 전체 프레임 이후의 diff는 이 프레임을 기준으로 계산
+    previous.resize((size_t)rows * cols);
+    for (size_t k = 0; k < previous.size(); ++k) {
+        previous[k] = glyphFor(cells[k]);
+    }
+    previousRows = rows;
+    previousCols = cols;
+    return length;
+}
+
+size_t FrameSerializer::renderDiff(const OccupancyGrid& grid)
+{
+    int rows = grid.rows();
+    int cols = grid.cols();
+    size_t cellCount = (size_t)rows * cols;
+    // 최악의 경우 칸마다 "\x1b[rrrrr;cccccH" + 문자
+    ensureCapacity(cellCount * 16 + 16);
+
+    char* p = out.data();
+    bool firstFrame = previous.size() != cellCount || previousRows != rows || previousCols != cols;
+    if (firstFrame) {
+        std::memcpy(p, "\x1b[2J", 4);
+        p += 4;
+        previous.assign(cellCount, '\0');
+        previousRows = rows;
+        previousCols = cols;
+    }
+
+    const Cell* cells = grid.data();
+    int cursorRow = -1, cursorCol = -1;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            size_t idx = (size_t)i * cols + j;
+            char glyph = glyphFor(cells[idx]);
+            if (glyph == previous[idx]) continue;
+            previous[idx] = glyph;
+            // 바로 앞 칸을 방금 썼다면 커서가 이미 여기 있으므로 이동 생략
+            if (i != cursorRow || j != cursorCol) {
+                *p++ = '\x1b';
+                *p++ = '[';
+                p = appendNumber(p, i + 1);
+                *p++ = ';';
+                p = appendNumber(p, j + 1);
+                *p++ = 'H';
+            }
+            *p++ = glyph;
+            cursorRow = i;
+            cursorCol = j + 1;
+        }
+    }
+    length = static_cast<size_t>(p - out.data());
+    return length;
+}
+
+bool FrameSerializer::writeTo(int fd) const
+{
+    const char* p = out.data();
+    size_t remaining = length;
+    while (remaining > 0) {
+        ssize_t written = ::write(fd, p, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef FREECELLS_H
+#define FREECELLS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <vector>
+#include "grid.h"
+#include "reachability.h"
+
+using namespace std;
+
+// 빈 칸(보이는 값이 EMPTY인 칸) 목록을 sparse set으로 유지
+// - dense: 빈 칸 인덱스를 빈틈없이 나열 → 무작위 칸을 O(1)로 뽑음
+// - slots: 칸 인덱스 → dense 위치 (NOT_FREE면 빈 칸 아님) → 추가·삭제 O(1) (삭제는 마지막 원소와 자리 바꿈)
+// 스폰 위치 선택은 pick(): 몇 번 무작위로 뽑아 보고, 모두 조건에 맞지 않으면 목록을 한 번 훑어 조건에 맞는 칸 중 고름
+// → 판이 거의 다 차도 최악 O(빈 칸 수)이며, 맞는 칸이 없으면 false (무한 대기 없음)
+class FreeCellSet
+{
+public:
+    static constexpr uint32_t NOT_FREE = UINT32_MAX;
+    // 목록을 훑기 전에 무작위로 뽑아 보는 횟수
+    static constexpr int SAMPLE_ATTEMPTS = 16;
+
+    explicit FreeCellSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // 격자 전체에서 다시 구성 (스테이지 시작 시)
+    void rebuild(const OccupancyGrid& grid);
+    // 격자에서 pos 칸이 바뀐 뒤 호출
+    void refresh(const OccupancyGrid& grid, const Coord& pos);
+
+    size_t size() const { return dense.size(); }
+    bool contains(const Coord& pos) const { return inBounds(pos) && slots[indexOf(pos)] != NOT_FREE; }
+    Coord at(size_t i) const { return Coord{(int)(dense[i] / gridCols), (int)(dense[i] % gridCols)}; }
+
+    // accept(Coord)가 true인 빈 칸 하나를 rng로 골라 out에 (맞는 칸이 없으면 false)
+    template <typename Accept>
+    bool pick(Accept accept, std::mt19937& rng, Coord& out) const;
+
+private:
+    int gridRows = 0, gridCols = 0;
+    std::pmr::vector<uint32_t> dense;
+    std::pmr::vector<uint32_t> slots;
+
+    bool inBounds(const Coord& pos) const
+    {
+        return pos.row >= 0 && pos.row < gridRows && pos.col >= 0 && pos.col < gridCols;
+    }
+    size_t indexOf(const Coord& pos) const { return (size_t)pos.row * gridCols + pos.col; }
+    void insert(uint32_t index);
+    void erase(uint32_t index);
+};
+
+FreeCellSet::FreeCellSet(std::pmr::memory_resource* resource)
+    : dense(resource), slots(resource)
+{
+}
+
+void FreeCellSet::rebuild(const OccupancyGrid& grid)
+{
+    gridRows = grid.rows();
+    gridCols = grid.cols();
+    size_t cellCount = (size_t)gridRows * gridCols;
+    slots.assign(cellCount, NOT_FREE);
+    dense.clear();
+    dense.reserve(cellCount);
+    const Cell* cells = grid.data();
+    for (size_t index = 0; index < cellCount; ++index) {
+        if (cells[index] == Cell::EMPTY) insert((uint32_t)index);
+    }
+}
+
+void FreeCellSet::refresh(const OccupancyGrid& grid, const Coord& pos)
+{
+    if (!inBounds(pos)) return;
+    uint32_t index = (uint32_t)indexOf(pos);
+    bool free = grid.at(pos) == Cell::EMPTY;
+    bool tracked = slots[index] != NOT_FREE;
+    if (free && !tracked) {
+        insert(index);
+    } else if (!free && tracked) {
+        erase(index);
+    }
+}
+
+void FreeCellSet::insert(uint32_t index)
+{
+    slots[index] = (uint32_t)dense.size();
+    dense.push_back(index);
+}
+
+void FreeCellSet::erase(uint32_t index)
+{
+    uint32_t slot = slots[index];
+    uint32_t last = dense.back();
+    dense[slot] = last;
+    slots[last] = slot;
+    dense.pop_back();
+    slots[index] = NOT_FREE;
+}
+
+template <typename Accept>
+bool FreeCellSet::pick(Accept accept, std::mt19937& rng, Coord& out) const
+{
+    if (dense.empty()) return false;
+    for (int attempt = 0; attempt < SAMPLE_ATTEMPTS; ++attempt) {
+        Coord pos = at((size_t)rng() % dense.size());
+        if (accept(pos)) {
+            out = pos;
+            return true;
+        }
+    }
+    // 맞는 칸이 드묾: 한 번 세고, 그중 무작위 순번의 칸을 다시 찾음 (추가 메모리 없이 두 번 훑기)
+    size_t matches = 0;
+    for (size_t i = 0; i < dense.size(); ++i) {
+        if (accept(at(i))) matches++;
+    }
+    if (matches == 0) return false;
+    size_t chosen = (size_t)rng() % matches;
+    for (size_t i = 0; i < dense.size(); ++i) {
+        Coord pos = at(i);
+        if (accept(pos) && chosen-- == 0) {
+            out = pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+// 아이템을 놓을 빈 칸 선택 (Game과 벤치마크가 같이 씀)
+// - 상하좌우가 모두 벽(게이트 포함)인 칸은 제외 (아이템이 벽에 갇히지 않게)
+// - reachable 요소 안의 칸을 우선, 없으면 그 조건은 빼고 고름
+// 놓을 칸이 전혀 없으면 false
+inline bool pickSpawnCell(const OccupancyGrid& grid, const FreeCellSet& freeCells, const ReachabilityMap& freeSpace,
+                          const ReachabilityMap::ReachableSet& reachable, std::mt19937& rng, Coord& out)
+{
+    auto surrounded = [&grid](const Coord& pos) {
+        int dr[4] = {-1, 1, 0, 0};
+        int dc[4] = {0, 0, -1, 1};
+        for (int d = 0; d < 4; ++d) {
+            Cell adj = grid.at(Coord{pos.row + dr[d], pos.col + dc[d]});
+            if (adj != Cell::WALL && adj != Cell::GATE) return false;
+        }
+        return true;
+    };
+    if (reachable.count > 0 && freeCells.pick([&](const Coord& cell) {
+            return reachable.contains(freeSpace.label(cell)) && !surrounded(cell);
+        }, rng, out)) {
+        return true;
+    }
+    return freeCells.pick([&](const Coord& cell) { return !surrounded(cell); }, rng, out);
+}
+
+#endif
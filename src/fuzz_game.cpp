@@ -0,0 +1,487 @@
+// 헤드리스 게임 퍼징·속성 검사 하네스
+// 입력 바이트열 = 시드 + 아이템 수 + 틱마다 넣을 키. 틱마다 불변식을 검사하고 어기면 abort
+//
+// libFuzzer:
+//   clang++ -std=c++20 -g -O1 -fsanitize=fuzzer,address -DSNAKE_LIBFUZZER src/fuzz_game.cpp -lncurses -pthread -o fuzz_game
+//   ./fuzz_game -max_len=4096 -timeout=5 corpus/
+// 단독 실행 (무작위 입력 생성, 재현):
+//   g++ -std=c++20 -O2 src/fuzz_game.cpp -lncurses -pthread -o fuzz_game
+//   ./fuzz_game --iterations 10000 --seed 1
+//   ./fuzz_game --replay crash-1a2b3c4d.bin
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "game.h"
+
+// 불변식 검사기: 틱 결과와 맵 상태를 보고 어긋나면 메시지를 남김
+class InvariantChecker
+{
+public:
+    // 벽 목록 전체 대조 주기 (매 틱은 점유 격자로 O(1) 검사)
+    static const uint64_t FULL_CHECK_INTERVAL = 256;
+
+    // 새 판(스테이지 시작·재도전) 직후 호출
+    void reset(const Game& game);
+    // 틱 하나가 끝난 뒤 호출. 어긋나면 false, failure()에 이유
+    bool check(const Game& game, TickResult result);
+    const char* failure() const { return reason; }
+
+private:
+    const char* reason = "";
+    uint64_t ticks = 0;
+    std::vector<Coord> itemCoords[3];
+    // 전체 재구성과 대조할 때 쓰는 작업 공간 (검사마다 다시 할당하지 않음)
+    ReachabilityMap freshSpace;
+    MinimapPyramid freshMinimap;
+    std::unordered_map<uint32_t, uint32_t> labelToFresh, freshToLabel;
+
+    static const Cell ITEM_KINDS[3];
+    bool fail(const char* why) { reason = why; return false; }
+    bool checkGates(const Map& map, bool full);
+    bool checkItems(const Map& map);
+    bool checkWallList(const Map& map);
+    bool checkFreeCells(const Map& map, const FreeCellSet& freeCells);
+    bool checkReachability(const Map& map, const ReachabilityMap& freeSpace);
+    bool checkMinimap(const Map& map, const MinimapPyramid& minimap);
+};
+
+const Cell InvariantChecker::ITEM_KINDS[3] = {Cell::GROWTH, Cell::POISON, Cell::TIME};
+
+void InvariantChecker::reset(const Game& game)
+{
+    const Map& map = game.map();
+    for (int k = 0; k < 3; ++k) {
+        itemCoords[k].resize(map.itemCount(ITEM_KINDS[k]));
+        for (size_t i = 0; i < itemCoords[k].size(); ++i) {
+            itemCoords[k][i] = map.itemCoord(ITEM_KINDS[k], i);
+        }
+    }
+}
+
+bool InvariantChecker::check(const Game& game, TickResult result)
+{
+    const Map& map = game.map();
+    const OccupancyGrid& grid = map.occupancy;
+    bool full = ++ticks % FULL_CHECK_INTERVAL == 0;
+
+    if (result == TickResult::RUNNING) {
+        // 1. Game Over 없이 길이가 3 미만으로 줄지 않음
+        if (map.snakeHeadObject.snakeBodySegments.size() < 3) {
+            return fail("body shorter than 3 without game over");
+        }
+        // 2. 머리가 벽 안에 있지 않음
+        Cell ground = grid.groundAt(map.snakeHeadObject.coord);
+        if (ground == Cell::WALL || ground == Cell::IMMUNE_WALL || ground == Cell::GATE || ground == Cell::BORDER) {
+            return fail("head inside a wall");
+        }
+        if (full) {
+            for (const Wall& wall : map.regularWalls) {
+                if (wall.coord == map.snakeHeadObject.coord) return fail("head inside regularWalls");
+            }
+        }
+    }
+    // 3. 게이트 쌍은 서로 다른 벽 위
+    if (!checkGates(map, full)) return false;
+    // 4. 새로 생긴 아이템은 빈 칸(스네이크·벽이 없는 칸)에만
+    if (!checkItems(map)) return false;
+    if (full && !checkWallList(map)) return false;
+    // 5. 빈 칸 목록이 점유 격자의 EMPTY 칸과 정확히 일치
+    if (full && !checkFreeCells(map, game.freeCellSet())) return false;
+    // 6. 점진적으로 유지한 연결 요소가 전체 재라벨링과 같은 분할 (라벨 번호는 달라도 됨)
+    if (full && !checkReachability(map, game.reachability())) return false;
+    // 7. 점진 갱신한 미니맵 블록 집계가 격자 전체에서 다시 센 것과 같음
+    if (full && !checkMinimap(map, game.minimapCounts())) return false;
+    return true;
+}
+
+bool InvariantChecker::checkGates(const Map& map, bool full)
+{
+    if (map.gameGates.size() != 2) return fail("gate count is not 2");
+    const Coord& a = map.gameGates[0].coord;
+    const Coord& b = map.gameGates[1].coord;
+    if (a == b) return fail("both gates on the same wall");
+    if (map.occupancy.groundAt(a) != Cell::GATE || map.occupancy.groundAt(b) != Cell::GATE) {
+        return fail("gate cell is not marked as gate");
+    }
+    if (full) {
+        bool foundA = false, foundB = false;
+        for (const Wall& wall : map.regularWalls) {
+            foundA = foundA || wall.coord == a;
+            foundB = foundB || wall.coord == b;
+        }
+        if (!foundA || !foundB) return fail("gate not on a regular wall");
+    }
+    return true;
+}
+
+bool InvariantChecker::checkItems(const Map& map)
+{
+    const OccupancyGrid& grid = map.occupancy;
+    for (int k = 0; k < 3; ++k) {
+        Cell kind = ITEM_KINDS[k];
+        if (itemCoords[k].size() != map.itemCount(kind)) return fail("item count changed");
+        for (size_t i = 0; i < itemCoords[k].size(); ++i) {
+            const Coord& pos = map.itemCoord(kind, i);
+            // 놓을 칸이 없어 치워 둔 아이템 (미배치)
+            if (pos == Coord{0, 0}) {
+                itemCoords[k][i] = pos;
+                continue;
+            }
+            if (grid.groundAt(pos) != kind || map.itemAt(pos) != (int)i) {
+                return fail("item index out of sync with grid");
+            }
+            if (pos == itemCoords[k][i]) continue;
+            // 이번 틱에 옮겨진 아이템
+            if (grid.snakeCount(pos) != 0) return fail("item spawned under the snake");
+            itemCoords[k][i] = pos;
+        }
+    }
+    return true;
+}
+
+bool InvariantChecker::checkFreeCells(const Map& map, const FreeCellSet& freeCells)
+{
+    const OccupancyGrid& grid = map.occupancy;
+    size_t empty = 0;
+    for (int row = 0; row < grid.rows(); ++row) {
+        for (int col = 0; col < grid.cols(); ++col) {
+            Coord pos{row, col};
+            bool isEmpty = grid.at(pos) == Cell::EMPTY;
+            if (isEmpty != freeCells.contains(pos)) return fail("free cell set out of sync with grid");
+            if (isEmpty) empty++;
+        }
+    }
+    if (empty != freeCells.size()) return fail("free cell set has duplicates");
+    return true;
+}
+
+bool InvariantChecker::checkReachability(const Map& map, const ReachabilityMap& freeSpace)
+{
+    const OccupancyGrid& grid = map.occupancy;
+    freshSpace.rebuild(grid);
+    if (freshSpace.componentCount() != freeSpace.componentCount()) return fail("reachability component count differs from rebuild");
+    // 두 라벨링 사이에 일대일 대응이 있고 요소 크기가 같아야 함
+    labelToFresh.clear();
+    freshToLabel.clear();
+    for (int row = 0; row < grid.rows(); ++row) {
+        for (int col = 0; col < grid.cols(); ++col) {
+            Coord pos{row, col};
+            uint32_t label = freeSpace.label(pos);
+            uint32_t fresh = freshSpace.label(pos);
+            if ((label == ReachabilityMap::BLOCKED) != (fresh == ReachabilityMap::BLOCKED)) {
+                return fail("reachability passable cells differ from rebuild");
+            }
+            if (label == ReachabilityMap::BLOCKED) continue;
+            auto forward = labelToFresh.emplace(label, fresh).first;
+            auto backward = freshToLabel.emplace(fresh, label).first;
+            if (forward->second != fresh || backward->second != label) {
+                return fail("reachability components differ from rebuild");
+            }
+        }
+    }
+    for (const auto& [label, fresh] : labelToFresh) {
+        if (freeSpace.componentSize(label) != freshSpace.componentSize(fresh)) {
+            return fail("reachability component size differs from rebuild");
+        }
+    }
+    return true;
+}
+
+bool InvariantChecker::checkMinimap(const Map& map, const MinimapPyramid& minimap)
+{
+    freshMinimap.rebuild(map.occupancy);
+    if (!(minimap == freshMinimap)) return fail("minimap counts differ from rebuild");
+    return true;
+}
+
+bool InvariantChecker::checkWallList(const Map& map)
+{
+    // 벽 목록과 점유 격자의 바닥 층이 일치
+    for (const Wall& wall : map.regularWalls) {
+        Cell ground = map.occupancy.groundAt(wall.coord);
+        if (ground != Cell::WALL && ground != Cell::GATE) return fail("wall missing from grid");
+    }
+    return true;
+}
+
+// 입력 한 개를 실행한 결과
+struct RunStats
+{
+    uint64_t ticks = 0;
+    uint64_t gameOvers = 0;
+    uint64_t stageClears = 0;
+};
+
+// 입력마다 다시 쓰는 헤드리스 게임 (newGame으로 새로 시작하므로 새로 만든 것과 같음)
+Game& fuzzGame()
+{
+    static Game game([] {
+        GameOptions options;
+        options.headless = true;
+        options.seed = 1;
+        options.trackMinimap = true;
+        return options;
+    }());
+    return game;
+}
+
+// 입력 형식: u32 시드 | u8 아이템 수 | 행동 바이트...
+//   0x00~0xDF : 하위 3비트 0~3 방향키(위·아래·왼쪽·오른쪽), 4~7 키 없음
+//   0xE0      : 미션 강제 완료 (디버그 키 D)
+//   0xE1~0xE5 : 스테이지 이동 (디버그 키 1~5)
+//   0xE6~0xEF : 조향. 직진·좌우 중 다음 칸이 비어 있는 쪽을 고름 (b & 3으로 우선순위를 돌림, 모두 막히면 직진)
+//   0xF0~0xFF : 키 없이 (b & 15) + 1틱 진행
+// 불변식을 어기거나 예외가 나면 메시지를 출력하고 false
+// 조향 바이트가 고른 키 (ERR이면 직진). 벽·테두리·몸통·독 아이템 칸은 피함
+int steerKey(const Map& map, uint8_t action)
+{
+    // processInput의 방향 번호: 1 위, 2 왼쪽, 3 오른쪽, 4 아래 (반대 방향 = 5 - d)
+    static const int KEYS[5] = {ERR, KEY_UP, KEY_LEFT, KEY_RIGHT, KEY_DOWN};
+    static const int DR[5] = {0, -1, 0, 0, 1};
+    static const int DC[5] = {0, 0, -1, 1, 0};
+    const SnakeHead& head = map.snakeHeadObject;
+    int current = head.currentDirection;
+    int choices[3];
+    int count = 0;
+    if (current < 1 || current > 4) {
+        // 아직 멈춰 있음: 몸통이 아래에 있으므로 위·왼쪽·오른쪽
+        choices[count++] = 1;
+        choices[count++] = 2;
+        choices[count++] = 3;
+    } else {
+        choices[count++] = current;
+        choices[count++] = current <= 1 || current >= 4 ? 2 : 1;
+        choices[count++] = 5 - choices[1];
+    }
+    for (int c = 0; c < count; ++c) {
+        int direction = choices[(c + (action & 3)) % count];
+        Cell next = map.occupancy.at({head.coord.row + DR[direction], head.coord.col + DC[direction]});
+        if (next == Cell::EMPTY || next == Cell::GATE || next == Cell::GROWTH || next == Cell::TIME) {
+            return direction == current ? ERR : KEYS[direction];
+        }
+    }
+    return ERR;
+}
+
+bool runActions(const uint8_t* data, size_t size, RunStats& stats)
+{
+    if (size < 5) return true;
+    uint32_t seed = ((uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24)) | 1u;
+    Game& game = fuzzGame();
+    game.newGame(seed, 1 + data[4] % 4);
+    InvariantChecker checker;
+    checker.reset(game);
+
+    static const int ARROWS[4] = {KEY_UP, KEY_DOWN, KEY_LEFT, KEY_RIGHT};
+    for (size_t at = 5; at < size; ++at) {
+        uint8_t action = data[at];
+        int key = ERR;
+        int repeat = 1;
+        if (action < 0xE0) {
+            key = (action & 4) ? ERR : ARROWS[action & 3];
+        } else if (action == 0xE0) {
+            key = 'd';
+        } else if (action <= 0xE5) {
+            key = '1' + (action - 0xE1);
+        } else if (action <= 0xEF) {
+            key = steerKey(game.map(), action);
+        } else {
+            repeat = (action & 15) + 1;
+        }
+
+        for (int r = 0; r < repeat; ++r) {
+            int stageBefore = game.stage();
+            TickResult result = game.tick(r == 0 ? key : ERR);
+            stats.ticks++;
+            if (!checker.check(game, result)) {
+                std::fprintf(stderr, "invariant violated at byte %zu (stage %d, tick %llu): %s\n",
+                             at, game.stage(), (unsigned long long)stats.ticks, checker.failure());
+                return false;
+            }
+            if (result == TickResult::GAME_OVER) {
+                stats.gameOvers++;
+                game.restartStage();
+            } else if (result == TickResult::MISSION_COMPLETE) {
+                stats.stageClears++;
+                game.advanceStage();
+            }
+            // 재도전·스테이지 이동(디버그 키 포함)이 있으면 아이템 기준 좌표를 새로 잡음
+            bool debugKey = r == 0 && action >= 0xE0 && action <= 0xE5;
+            if (result != TickResult::RUNNING || game.stage() != stageBefore || debugKey) {
+                checker.reset(game);
+            }
+        }
+    }
+    return true;
+}
+
+bool runInput(const uint8_t* data, size_t size, RunStats& stats)
+{
+    try {
+        return runActions(data, size, stats);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "exception after %llu ticks: %s\n", (unsigned long long)stats.ticks, e.what());
+        return false;
+    }
+}
+
+#ifdef SNAKE_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    RunStats stats;
+    if (!runInput(data, size, stats)) std::abort();
+    return 0;
+}
+
+#else
+
+// 현재 입력 (시간 초과 시 시그널 핸들러가 파일로 남김)
+static std::vector<uint8_t> currentInput;
+
+uint32_t fnv1a(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+void saveInput(const char* prefix)
+{
+    char path[64];
+    std::snprintf(path, sizeof(path), "%s-%08x.bin", prefix, fnv1a(currentInput.data(), currentInput.size()));
+    int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+    ssize_t written = ::write(fd, currentInput.data(), currentInput.size());
+    ::close(fd);
+    if (written == (ssize_t)currentInput.size()) std::fprintf(stderr, "input saved to %s\n", path);
+}
+
+void onTimeout(int)
+{
+    // 무한 루프로 보고 입력을 남기고 종료 (시그널 안전한 호출만 사용)
+    static const char message[] = "input timed out, saved to hang.bin\n";
+    int fd = ::open("hang.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        ssize_t ignored = ::write(fd, currentInput.data(), currentInput.size());
+        (void)ignored;
+        ::close(fd);
+    }
+    ssize_t ignored = ::write(STDERR_FILENO, message, sizeof(message) - 1);
+    (void)ignored;
+    _exit(3);
+}
+
+bool readFile(const char* path, std::vector<uint8_t>& out)
+{
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+    out.clear();
+    uint8_t buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) out.insert(out.end(), buffer, buffer + n);
+    std::fclose(file);
+    return true;
+}
+
+// 무작위 입력 하나를 만듦. 균일한 무작위 바이트는 열 틱 남짓마다 판이 끝나 재시작 비용만 재게 되므로
+// 오래 살아남는 쪽으로 치우침: 대부분 조향 바이트, 가끔 맹목 방향키·대기, 드물게 디버그 키
+void makeInput(std::mt19937& rng, size_t size, std::vector<uint8_t>& out)
+{
+    out.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        uint32_t roll = rng() % 1000;
+        if (i < 5) {
+            out[i] = (uint8_t)rng();
+        } else if (roll < 3) {
+            out[i] = (uint8_t)(0xE0 + rng() % 6);
+        } else if (roll < 30) {
+            out[i] = (uint8_t)(rng() % 0xE0);
+        } else if (roll < 60) {
+            out[i] = (uint8_t)(0xF0 + rng() % 4);
+        } else {
+            out[i] = (uint8_t)(0xE6 + rng() % 10);
+        }
+    }
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--iterations N] [--seed N] [--length N] [--timeout SEC]" << std::endl;
+    std::cerr << "       " << program << " --replay FILE..." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    long iterations = 10000;    // 0이면 무한
+    uint32_t seed = 1;
+    size_t length = 4096;
+    unsigned timeoutSeconds = 10;
+    std::vector<const char*> replays;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--iterations") == 0 && hasValue) {
+            iterations = std::atol(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--length") == 0 && hasValue) {
+            length = std::max<size_t>(6, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--timeout") == 0 && hasValue) {
+            timeoutSeconds = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--replay") == 0) {
+            while (i + 1 < argc) replays.push_back(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    std::signal(SIGALRM, onTimeout);
+
+    RunStats stats;
+    if (!replays.empty()) {
+        for (const char* path : replays) {
+            if (!readFile(path, currentInput)) {
+                std::cerr << "Failed to read " << path << std::endl;
+                return 1;
+            }
+            alarm(timeoutSeconds);
+            bool ok = runInput(currentInput.data(), currentInput.size(), stats);
+            alarm(0);
+            std::cout << path << ": " << (ok ? "ok" : "FAILED") << " (" << stats.ticks << " ticks)" << std::endl;
+            if (!ok) return 1;
+        }
+        return 0;
+    }
+
+    // 입력 길이·내용을 무작위로 만들어 반복 실행
+    std::mt19937 rng(seed);
+    auto start = std::chrono::steady_clock::now();
+    for (long n = 0; iterations == 0 || n < iterations; ++n) {
+        makeInput(rng, 5 + rng() % (length - 5), currentInput);
+        alarm(timeoutSeconds);
+        bool ok = runInput(currentInput.data(), currentInput.size(), stats);
+        alarm(0);
+        if (!ok) {
+            saveInput("crash");
+            std::abort();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << iterations << " inputs, " << stats.ticks << " ticks in " << seconds << " s ("
+              << (uint64_t)(stats.ticks / seconds) << " ticks/s), "
+              << stats.gameOvers << " game overs, " << stats.stageClears << " stage clears" << std::endl;
+    return 0;
+}
+
+#endif
@@ -3,84 +3,139 @@
 
 #include "map.h"
 #include "block.h"
+#include "arena.h"
+#include "profiler.h"
+#include "events.h"
+#include "mission.h"
+#include "timer_wheel.h"
+#include "reachability.h"
+#include "freecells.h"
+#include "scheduler.h"
+#include "spectator.h"
+#include "telemetry.h"
+#include "highscore.h"
+#include "stats.h"
+#include "input.h"
+#include "renderer.h"
+#include "viewport.h"
+#include "uiloop.h"
 #include <iostream>
 #include <vector>
 #include <ncurses.h>
 #include <unistd.h>
 #include <cstdlib>
 #include <ctime>
+#include <cstdio>
 #include <cstring>
 #include <chrono>
 #include <queue>
 #include <set>
 #include <stdexcept>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <exception>
 
 using namespace std;
 
-// RAII 패턴을 위한 ncurses 윈도우 래퍼 클래스
-class WindowWrapper {
-private:
-    WINDOW* window;
-    
-public:
-    WindowWrapper(int height, int width, int starty, int startx) 
-        : window(newwin(height, width, starty, startx)) {
-        if (!window) {
-            throw std::runtime_error("Failed to create ncurses window");
-        }
-    }
-    
-    ~WindowWrapper() {
-        if (window) {
-            delwin(window);
-        }
-    }
-    
-    // 복사 방지
-    WindowWrapper(const WindowWrapper&) = delete;
-    WindowWrapper& operator=(const WindowWrapper&) = delete;
-    
-    // 이동 생성자/대입 연산자
-    WindowWrapper(WindowWrapper&& other) noexcept : window(other.window) {
-        other.window = nullptr;
-    }
-    
-    WindowWrapper& operator=(WindowWrapper&& other) noexcept {
-        if (this != &other) {
-            if (window) {
-                delwin(window);
-            }
-            window = other.window;
-            other.window = nullptr;
-        }
-        return *this;
-    }
-    
-    WINDOW* get() const { return window; }
-    operator WINDOW*() const { return window; }
+// 게임 실행 옵션
+struct GameOptions
+{
+    bool headless = false;      // true면 ncurses를 초기화하지 않음 (tick()으로만 진행)
+    unsigned int seed = 0;      // 0이면 현재 시간으로 초기화
+    InputThread* input = nullptr;   // 키 입력 스레드 (없으면 ncurses getch 사용)
+    int itemsPerType = 1;       // 종류별로 동시에 놓이는 아이템 수
+    int simHz = 1000;           // 시뮬레이션 고정 스텝 주기 (1~10000Hz)
+    double speedScale = 1.0;    // 스네이크 기본 속도 배율 (빠른 모드)
+    int mapHeight = 21;         // 맵 크기 (터미널보다 크면 보드가 머리를 따라 스크롤)
+    int mapWidth = 41;
+    // 게임이 쓰는 메모리(아레나 청크, 색인·타이머·미션 배열)를 받을 곳 (nullptr이면 힙, 배치 실행은 워커 스레드의 메모리)
+    std::pmr::memory_resource* memory = nullptr;
+    bool trackMinimap = false;  // 미니맵을 보이지 않아도 블록 집계를 유지 (퍼저가 재구성 결과와 대조)
+
+    std::pmr::memory_resource* resource() const { return memory ? memory : std::pmr::get_default_resource(); }
 };
 
-class Game
+// 타이머 휠에 거는 시한 효과 종류
+enum class TimerTag : uint16_t {
+    GROWTH_RESPAWN,     // 먹지 않은 아이템을 다른 곳에 다시 생성 (data: 아이템 인덱스)
+    POISON_RESPAWN,
+    TIME_RESPAWN,
+    SPEED_BOOST_END,
+    GATE_EXPIRE         // 게이트 통과가 끝나 비활성화
+};
+
+// tick() 한 번의 결과
+enum class TickResult {
+    RUNNING,
+    GAME_OVER,
+    MISSION_COMPLETE
+};
+
+class Game : private GameEventSink
 {
 public:
-    Game();
+    Game(const GameOptions& options = GameOptions());
     ~Game();
 
-    void refreshScreen();
-    bool update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer, int previousDirection = 0);
+    // 대화형 진행 (렌더 스레드로 화면 출력). 사용자가 모달 화면에서 종료를 고르면 끝남
+    UiTask<> play(UiLoop& loop);
+    // 입력 하나를 처리하고 게임을 한 틱 진행 (화면 출력 없음)
+    TickResult tick(int key);
+    // 헤드리스 진행용: Game Over 후 재도전 / 미션 완료 후 다음 스테이지
+    void restartStage() { resetCurrentStage(); }
+    void advanceStage() { goToNextStage(); }
+    // 같은 객체로 스테이지 1부터 새 게임 (시드·아이템 수 교체). 진행은 이 옵션으로 새로 만든 Game과 같음
+    // 퍼저처럼 짧은 게임을 많이 돌릴 때 객체·아레나·색인 메모리를 다시 만들지 않음
+    void newGame(unsigned int seed, int itemsPerType);
+    const Map& map() const { return *gameMap; }
+    // 빈 공간 연결 요소 (자동 조종 등이 갈 곳을 고를 때 사용)
+    const ReachabilityMap& reachability() const { return freeSpace; }
+    // 현재 스테이지 미션 진행 (자동 조종이 남은 목표를 고를 때 사용)
+    const MissionTracker& missionProgress() const { return missions; }
+    // 빈 칸 목록 (스폰 위치 후보)
+    const FreeCellSet& freeCellSet() const { return freeCells; }
+    // 미니맵 블록 집계 (카메라가 미니맵을 보이거나 trackMinimap일 때만 유지)
+    const MinimapPyramid& minimapCounts() const { return minimap; }
+    // 스네이크가 스스로 갇혀 곧 죽을 상태인지
+    bool snakeDoomed() const;
+    int stage() const { return currentStage; }
+    // 이번 판 최대 길이 (점수)
+    int maxLength() const { return maxSnakeLength; }
+    // 틱마다 델타를 관전 서버로 발행 (nullptr이면 해제)
+    void attachSpectator(SpectatorServer* server);
+    // 틱·판 단위 지표를 텔레메트리 파일로 기록 (nullptr이면 해제)
+    void attachTelemetry(TelemetryWriter* writer);
+    // 판이 끝날 때마다 최대 길이를 점수 저장소에 기록하고 Game Over 화면에 순위 표시 (nullptr이면 해제)
+    void attachHighScores(HighScoreStore* store) { highScores = store; }
+    // 아이템·게이트·사망 원인을 병렬 실행 통계(판 집계 → 워커 샤드)로 집계 (nullptr이면 해제, 판 끝은 호출자가 알림)
+    void attachStats(StatsRun* run);
+    bool update(int previousDirection = 0);
     bool isValid(int /*previousDirection*/);
-    void generateRandCoord(int &row, int &col, bool shouldIncludeWall = false);
+    // 아이템을 놓을 빈 칸을 고름 (놓을 칸이 없으면 false)
+    bool generateRandCoord(int &row, int &col);
     void generateGate();
     void generateItems();
-    void generateTItem();
-    void generateGItem();
-    void generatePItem();
+    // kind(Cell::GROWTH/POISON/TIME)의 index번 아이템을 빈 칸에 다시 배치
+    void spawnItem(Cell kind, size_t index);
 
 private:
-    Map gameMap;
+    // 멤버는 틱마다 쓰는 상태와 스테이지 시작·화면 출력 때만 쓰는 상태로 나눠 적음 (읽기 편하도록 묶은 것일 뿐
+    // 캐시 배치는 아님: 객체가 15KB쯤이고 틱 쪽에도 사건 큐·타이머 휠 슬롯처럼 큰 배열이 있음)
+
+    // --- 틱마다 쓰는 상태 ---
+    // 스테이지 아레나 두 개: 하나는 현재 스테이지의 Map(벽·게이트·몸통), 다른 하나는 다음 스테이지 준비용
+    // 스테이지 전환은 두 슬롯을 맞바꿈. 준비하는 쪽 슬롯은 이전 Map을 파괴한 뒤 O(1) 해제
+    // 프레임 아레나: 한 틱 안에서만 쓰는 임시 버퍼용, 매 틱 시작 시 reset
+    // (stageMaps보다 먼저 선언해야 Map이 먼저 파괴됨)
+    Arena stageArenas[2];
+    Arena frameArena;
+    std::optional<Map> stageMaps[2];
+    Map* gameMap = nullptr;         // stageMaps[activeSlot]
+    int activeSlot = 0;
     int currentStage = 1;
-    int gateActiveDuration = 0;
     int growthItemCount = 0;
     int poisonItemCount = 0;
     int gatesUsedCount = 0;
@@ -88,54 +143,204 @@ private:
     int gameTimerSeconds = 0;
     int gameSpeedDelay = 200;
     float speedMultiplier = 1;
-    int speedBoostTimer = 0;
-    
-    // 아이템 타이머들을 멤버 변수로 추가
-    int growthItemTimer = 0;
-    int poisonItemTimer = 0;
-    int timeItemTimer = 0;
-
-    char missionSnakeLengthStatus = ' ';
-    char missionGrowthItemStatus = ' ';
-    char missionPoisonItemStatus = ' ';
-    char missionGateUseStatus = ' ';
-    string gameOverReason = "";
-
-    bool allMissionsCompleted = false;
+    DeathReason deathReason = DeathReason::NONE;
+    uint64_t tickCount = 0;
+    uint32_t soundCues = 0;         // 효과음 낼 사건 누적 수 (렌더 스레드가 beep)
+
+    // 아직 적용하지 않은 방향 입력 (틱마다 하나씩 적용해 빠른 연속 회전이 사라지지 않게 함)
+    static const int TURN_BUFFER_SIZE = 4;
+    int turnBuffer[TURN_BUFFER_SIZE];
+    int turnCount = 0;
+
+    SpectatorServer* spectator = nullptr;
+    TelemetryWriter* telemetry = nullptr;
+    HighScoreStore* highScores = nullptr;
+    StatsRun* stats = nullptr;
+
+    // 빈 공간 연결 요소 라벨 (emitCell마다 바뀐 칸만 반영, 스테이지 시작 시 전체 재구성)
+    ReachabilityMap freeSpace;
+    // 빈 칸 목록 (아이템 스폰 위치 선택용, 갱신 시점은 freeSpace와 같음)
+    FreeCellSet freeCells;
+
+    // 시한 효과는 모두 타이머 휠로 관리 (스네이크가 움직인 틱만 셈)
+    static const uint32_t ITEM_RESPAWN_TICKS = 50;
+    static const uint32_t SPEED_BOOST_TICKS = 40;
+    TimerWheel timers;
+    std::pmr::vector<TimerWheel::TimerId> respawnTimers[3];    // 아이템마다 하나 (GROWTH/POISON/TIME 순)
+    TimerWheel::TimerId speedBoostTimer = TimerWheel::NO_TIMER;
+    TimerWheel::TimerId gateExpiryTimer = TimerWheel::NO_TIMER;
+
+    EventQueue events;
+    MissionTracker missions;
+
+    // --- 스폰·스테이지 시작·화면 출력 때만 쓰는 상태 ---
+    // 아이템·게이트 위치용 난수 (게임마다 따로 두므로 여러 게임을 여러 스레드에서 동시에 돌릴 수 있음)
+    std::mt19937 rng;
+    GameOptions options;
+    // 스테이지별 정적 레이아웃 캐시 (벽·스네이크 시작 위치만 있는 갓 생성한 Map)
+    // 스테이지를 처음 시작할 때 한 번 생성하고, 이후 재도전은 스테이지 아레나로 복사만 함
+    static const int STAGE_COUNT = 4;
+    Arena layoutArena;
+    std::optional<Map> stageLayouts[STAGE_COUNT];
+    // 게이트 후보 벽 목록 (재사용해 게이트를 다시 놓을 때 할당 없음)
+    std::pmr::vector<int> gateCandidates;
+    // 대기 슬롯에 미리 만들어 둔 스테이지: 아이템·게이트까지 놓은 Map, 빈 공간 색인, 미션, 재생성 타이머
+    // 미션 완료 화면이 키를 기다리는 동안 작업 스레드가 채우고, 스테이지 전환 때 현재 상태와 swap
+    struct StagePrep
+    {
+        // 준비 중에 난 사건을 모아 두는 구독자 (전환 때 게임 사건 큐로 옮겨 발행)
+        struct Deferred : GameEventSink
+        {
+            explicit Deferred(std::pmr::memory_resource* memory) : events(memory) {}
+            void onEvent(const GameEvent& event) override { events.push_back(event); }
+            std::pmr::vector<GameEvent> events;
+        };
+
+        explicit StagePrep(std::pmr::memory_resource* memory)
+            : freeSpace(memory), freeCells(memory), minimap(memory), gateCandidates(memory), timers(64, memory)
+            , respawnTimers{std::pmr::vector<TimerWheel::TimerId>(memory), std::pmr::vector<TimerWheel::TimerId>(memory),
+                            std::pmr::vector<TimerWheel::TimerId>(memory)}
+            , deferred(memory), missions(queue, memory)
+        {
+            queue.subscribe(&deferred);
+        }
+
+        int stage = 0;                  // 준비된 스테이지 (0이면 없음)
+        ReachabilityMap freeSpace;
+        FreeCellSet freeCells;
+        MinimapPyramid minimap;
+        bool trackedMinimap = false;    // minimap을 집계했는지 (준비 때 tracksMinimap())
+        std::mt19937 rng;               // 준비를 시작할 때 게임 난수에서 갈라낸 스테이지 난수 (아이템·게이트 배치)
+        std::pmr::vector<int> gateCandidates;
+        TimerWheel timers;
+        std::pmr::vector<TimerWheel::TimerId> respawnTimers[3];
+        EventQueue queue;
+        Deferred deferred;
+        MissionTracker missions;
+        std::thread worker;
+        std::exception_ptr error;       // 작업 스레드에서 난 예외 (스테이지 전환 때 다시 던짐)
+    } prep;
     bool ncursesInitialized = false;
+    uint64_t lastRank = 0;          // 마지막으로 끝난 판의 스테이지 내 순위 (0이면 기록 안 됨)
+    uint64_t lastRankOf = 0;        // 그때 스테이지 보드의 기록 수
+    Renderer* renderer = nullptr;   // play() 동안만 유효
+    Viewport camera;                // 보드에 보이는 맵 영역 (터미널 크기로 정함, 헤드리스는 쓰지 않음)
+    MinimapPyramid minimap;         // 미니맵 블록 집계 (tracksMinimap()일 때만 유지)
+    AccumulatorScheduler* scheduler = nullptr;     // play() 동안만 유효
+    bool endingRequested = false;   // 디버그 키로 엔딩 화면 요청 (다음 틱 뒤 play()가 보여 줌)
+    AccumulatorScheduler::EntityId snakeEntity = 0;
+
+#ifdef SNAKE_INSTRUMENT
+    TickProfiler tickProfiler;
+#endif
 
     void initializeNcurses();
     void cleanupNcurses();
-    void drawBoard(WINDOW* board);
-    void drawScore(WINDOW* score);
-    void drawMission(WINDOW* mission);
-    void handleGameOver();
-    void handleMissionComplete();
-    void checkMissions();
+    // 현재 상태를 렌더 스레드용 스냅샷에 복사
+    // 보이는 영역만 복사하며, 그 전에 카메라가 머리를 따라감
+    void captureFrame(FrameSnapshot& frame);
+    void captureMinimap(FrameSnapshot& frame) const;
+    bool tracksMinimap() const { return camera.showsMinimap() || options.trackMinimap; }
+    // 모달 화면(Game Over 등)이 ncurses를 직접 쓰기 전에 렌더 스레드를 멈춤
+    void pauseRenderer();
+    // 초당 칸 수 (gameSpeedDelay, 속도 부스트, 속도 배율 반영)
+    double snakeSpeed() const;
+    // 점수판에 표시하는 경과 초
+    int elapsedSeconds() const { return gameTimerSeconds / (1000 / gameSpeedDelay); }
+    // 끝난 판의 점수를 저장하고 순위 갱신
+    void recordScore();
+    // 모달 화면 (키를 기다리는 동안 이벤트 루프에 양보)
+    // Game Over: true면 재도전, false면 종료 / 미션 완료: true면 다음 스테이지, false면 종료
+    UiTask<bool> gameOverScreen(UiLoop& loop);
+    UiTask<bool> missionCompleteScreen(UiLoop& loop);
+    // 모든 스테이지 클리어: true면 다시 시작, false면 종료
+    UiTask<bool> endingScreen(UiLoop& loop);
     void processInput(int key);
-    void updateTimers(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer);
+    void queueKey(int key);
+    int nextTurn();
+    int readKey();
+    // 기존 타이머를 취소하고 delay틱 뒤로 다시 검
+    void restartTimer(TimerWheel::TimerId& timer, uint32_t delay, TimerTag tag);
+    void onTimer(uint16_t tag, uint32_t data);
+    void restartRespawn(Cell kind, size_t index);
+    static TimerWheel::TimerId scheduleRespawn(TimerWheel& wheel, Cell kind, size_t index);
+    static int itemSlot(Cell kind);
+    static ItemKind itemKindOf(Cell kind);
     void handleGateCollision();
     void handleItemCollisions();
     void resetCurrentStage();
+    // 현재 스테이지로 전환: 준비된 대기 슬롯이 있으면 교체만 하고, 없으면 그 자리에서 준비한 뒤 교체
+    void loadStageLayout();
+    // stage의 캐시된 레이아웃을 대기 슬롯 아레나에 복원하고 빈 공간 색인 구성 (캐시가 없으면 생성),
+    // seed로 만든 스테이지 난수로 아이템·게이트를 놓고 미션·재생성 타이머까지 준비
+    // 현재 스테이지 상태는 건드리지 않으므로 작업 스레드에서 돌려도 됨 (seed는 호출하는 쪽이 게임 난수에서 뽑음)
+    void prepareStage(int stage, uint32_t seed);
+    // prepareStage를 작업 스레드에서 시작 / 끝날 때까지 대기
+    void startStagePrep(int stage);
+    void joinStagePrep();
+    // 준비하면서 모아 둔 사건(미션 초기 달성, 아이템 배치)을 게임 사건 큐로 발행
+    void emitPreparedEvents();
     void goToNextStage();
     MapType getMapTypeForStage(int stage);
-    void showEndingScreen();
     
     // 안전한 벡터 접근을 위한 헬퍼 함수들
     bool isSnakeBodySizeValid(size_t requiredSize) const;
     void safeAddSnakeBody();
     bool safeRemoveSnakeBody();
     void validateTerminalSize();
+    // 아이템·게이트를 놓을 판: 현재 스테이지(liveBoard) 또는 준비 중인 대기 슬롯
+    // 배치 코드는 이 판만 보므로 같은 코드가 틱 스레드와 작업 스레드 양쪽에서 돔
+    struct StageBoard
+    {
+        Map& map;
+        ReachabilityMap& freeSpace;
+        FreeCellSet& freeCells;
+        MinimapPyramid* minimap;        // 집계하지 않으면 nullptr
+        std::mt19937& rng;
+        std::pmr::vector<int>& gateCandidates;
+        EventQueue& events;
+    };
+    StageBoard liveBoard();
+    bool pickItemCell(StageBoard& board, Coord& pos);
+    void placeItems(StageBoard& board);
+    void placeItem(StageBoard& board, Cell kind, size_t index);
+    void placeGates(StageBoard& board);
+    // 칸 변경 사건 발행 (현재 점유 격자 값을 함께 실음)
+    void emitCell(EventType type, const Coord& pos);
+    void emitItem(EventType type, ItemKind kind, const Coord& pos);
+    void emitCell(StageBoard& board, EventType type, const Coord& pos);
+    void emitItem(StageBoard& board, EventType type, ItemKind kind, const Coord& pos);
+    bool gameOver(DeathReason reason);
+    // 점수·효과음 갱신 (틱 끝에 한꺼번에 전달받음, 미션은 MissionTracker가 따로 구독)
+    void onEvent(const GameEvent& event) override;
 };
 
-Game::Game()
+Game::Game(const GameOptions& options)
+    : stageArenas{Arena(64 * 1024, options.memory), Arena(64 * 1024, options.memory)}
+    , frameArena(16 * 1024, options.memory)
+    , freeSpace(options.resource())
+    , freeCells(options.resource())
+    , timers(64, options.resource())
+    , respawnTimers{std::pmr::vector<TimerWheel::TimerId>(options.resource()),
+                    std::pmr::vector<TimerWheel::TimerId>(options.resource()),
+                    std::pmr::vector<TimerWheel::TimerId>(options.resource())}
+    , missions(events, options.resource())
+    , rng(options.seed ? options.seed : static_cast<unsigned int>(time(nullptr)))
+    , options(options)
+    , layoutArena(32 * 1024, options.memory)
+    , gateCandidates(options.resource())
+    , prep(options.resource())
+    , minimap(options.resource())
 {
+    events.subscribe(this);
+    events.subscribe(&missions);
     try {
-        gameMap = Map(21, 41, 2);
-        initializeNcurses();
-        validateTerminalSize();
-        generateItems();
-        generateGate();
+        loadStageLayout();
+        if (!options.headless) {
+            initializeNcurses();
+            validateTerminalSize();
+        }
+        emitPreparedEvents();
         
         // 초기 게임 속도를 0.2초(200ms)로 설정
         gameSpeedDelay = 200;
@@ -147,6 +352,7 @@ Game::Game()
 
 Game::~Game()
 {
+    joinStagePrep();
     cleanupNcurses();
 }
 
@@ -181,7 +387,6 @@ void Game::initializeNcurses()
     
     keypad(stdscr, TRUE);
     nodelay(stdscr, TRUE);
-    srand(static_cast<unsigned int>(time(nullptr)));
 }
 
 void Game::cleanupNcurses()
@@ -197,8 +402,9 @@ void Game::validateTerminalSize()
     int term_rows, term_cols;
     getmaxyx(stdscr, term_rows, term_cols);
     
-    int required_width = gameMap.mapSize.width + 35;  // 맵 + UI 공간
-    int required_height = gameMap.mapSize.height + 5; // 맵 + 여유 공간
+    // 맵 전체가 들어갈 필요는 없음 (작으면 보드가 스크롤). 보드 최소 영역 + UI 공간만 확인
+    int required_width = Viewport::requiredCols(gameMap->mapSize.width);
+    int required_height = Viewport::requiredRows(gameMap->mapSize.height);
     
     if (term_rows < required_height || term_cols < required_width) {
         cleanupNcurses();
@@ -206,175 +412,367 @@ void Game::validateTerminalSize()
                                 std::to_string(required_width) + "x" + 
                                 std::to_string(required_height));
     }
+    camera = Viewport(gameMap->mapSize.height, gameMap->mapSize.width, term_rows, term_cols);
+    camera.center(gameMap->snakeHeadObject.coord);
+    if (tracksMinimap()) minimap.rebuild(gameMap->occupancy);
 }
 
 bool Game::isSnakeBodySizeValid(size_t requiredSize) const
 {
-    return gameMap.snakeHeadObject.snakeBodySegments.size() >= requiredSize;
+    return gameMap->snakeHeadObject.snakeBodySegments.size() >= requiredSize;
 }
 
 void Game::safeAddSnakeBody()
 {
     if (!isSnakeBodySizeValid(2)) {
         // 몸통이 2개 미만이면 기본 위치에 추가
-        Coord headPos = gameMap.snakeHeadObject.coord;
-        gameMap.snakeHeadObject.snakeBodySegments.push_back(
+        Coord headPos = gameMap->snakeHeadObject.coord;
+        gameMap->snakeHeadObject.snakeBodySegments.push_back(
             SnakeBody(headPos.row + 1, headPos.col));
+        gameMap->occupancy.enterSnake(gameMap->snakeHeadObject.snakeBodySegments.back().coord, Cell::BODY);
+        emitCell(EventType::CELL_CHANGED, gameMap->snakeHeadObject.snakeBodySegments.back().coord);
         return;
     }
     
-    auto& segments = gameMap.snakeHeadObject.snakeBodySegments;
-    auto last = segments.end() - 1;
-    auto sec = segments.end() - 2;
+    auto& segments = gameMap->snakeHeadObject.snakeBodySegments;
+    const Coord last = segments.end()[-1].coord;
+    const Coord sec = segments.end()[-2].coord;
     
-    segments.push_back(SnakeBody(
-        last->coord.row - (sec->coord.row - last->coord.row),
-        last->coord.col - (sec->coord.col - last->coord.col)
-    ));
+    // 꼬리 방향으로 한 칸 연장. 그 칸이 빈 칸이 아니거나(벽·아이템·몸통),
+    // 마지막 두 마디가 이웃하지 않으면(게이트를 건넌 직후·겹친 마디) 꼬리 칸에 겹쳐 둠
+    // (겹친 마디는 스네이크가 움직이면서 자연스럽게 펼쳐짐)
+    Coord grown{last.row - (sec.row - last.row), last.col - (sec.col - last.col)};
+    bool adjacent = std::abs(sec.row - last.row) + std::abs(sec.col - last.col) == 1;
+    if (!adjacent || gameMap->occupancy.at(grown) != Cell::EMPTY) {
+        grown = last;
+    }
+    segments.push_back(SnakeBody(grown.row, grown.col));
+    gameMap->occupancy.enterSnake(segments.back().coord, Cell::BODY);
+    emitCell(EventType::CELL_CHANGED, segments.back().coord);
 }
 
 bool Game::safeRemoveSnakeBody()
 {
-    if (gameMap.snakeHeadObject.snakeBodySegments.size() <= 3) {
+    if (gameMap->snakeHeadObject.snakeBodySegments.size() <= 3) {
         return false; // 최소 길이 유지
     }
     
-    gameMap.snakeHeadObject.snakeBodySegments.pop_back();
+    Coord tail = gameMap->snakeHeadObject.snakeBodySegments.back().coord;
+    gameMap->occupancy.leaveSnake(tail);
+    gameMap->snakeHeadObject.snakeBodySegments.pop_back();
+    emitCell(EventType::TAIL_VACATED, tail);
     return true;
 }
 
-void Game::refreshScreen()
+UiTask<> Game::play(UiLoop& loop)
 {
     try {
-        while (true) {
-            clear();
-            
-            // RAII 패턴으로 윈도우 자동 관리
-            WindowWrapper board(gameMap.mapSize.height + 2, gameMap.mapSize.width + 2, 0, 0);
-            WindowWrapper score(9, 27, 0, gameMap.mapSize.width + 4);
-            WindowWrapper mission(9, 27, 10, gameMap.mapSize.width + 4);
-
-            box(board.get(), 0, 0);
-            box(score.get(), 0, 0);
-            box(mission.get(), 0, 0);
+        // 시뮬레이션은 이 코루틴, 화면 출력은 렌더 스레드에서 진행
+        Renderer screen(camera.rows(), camera.cols(), camera.showsMinimap());
+        renderer = &screen;
+        // 고정 주기 스텝으로 시간을 재고, 스네이크는 자기 속도만큼 칸을 옮김 (한 칸 이동 = 게임 한 틱)
+        AccumulatorScheduler clock(options.simHz);
+        scheduler = &clock;
+        snakeEntity = clock.addEntity(snakeSpeed());
+        captureFrame(screen.writeBuffer());
+        screen.publish();
 
-            drawBoard(board.get());
-            drawScore(score.get());
-            drawMission(mission.get());
+        bool playing = true;
+        while (playing) {
+            // 모달 화면에서 돌아오면 렌더 스레드 재시작, 스텝 기준 시각도 다시 잡음
+            if (!screen.running()) {
+                screen.start();
+                clock.resync(std::chrono::steady_clock::now());
+            }
 
-            refresh();
-            wrefresh(board.get());
-            wrefresh(score.get());
-            wrefresh(mission.get());
+            AccumulatorScheduler::EntityId entity;
+            if (!clock.nextMove(std::chrono::steady_clock::now(), entity)) {
+                // 다음 이동까지 이벤트 루프에 양보
+                co_await loop.sleepUntil(clock.nextMoveTime());
+                continue;
+            }
 
-            int key = getch();
-            int previousDirection = gameMap.snakeHeadObject.currentDirection;
-            processInput(key);
+            SNAKE_PROFILE_BEGIN(currentStage);
 
-            if (allMissionsCompleted) {
-                handleMissionComplete();
-                continue;
+            // 지난 틱 이후 들어온 키를 모두 꺼내 회전 버퍼에 쌓음
+            int key;
+            while ((key = readKey()) != ERR) {
+                queueKey(key);
             }
+            TickResult result = tick(ERR);
+            // 속도 부스트 시작/종료가 다음 스텝부터 바로 반영됨
+            clock.setSpeed(snakeEntity, snakeSpeed());
+            captureFrame(screen.writeBuffer());
+            screen.publish();
+            // 작업 시간은 모달 화면을 띄우기 전까지만 (화면에서 기다린 시간은 간격 쪽에만 잡힘)
+            SNAKE_PROFILE_END(static_cast<float>(1000.0 / snakeSpeed()));
 
-            if (!update(growthItemTimer, poisonItemTimer, timeItemTimer, previousDirection)) {
-                handleGameOver();
+            if (result == TickResult::MISSION_COMPLETE) {
+                SNAKE_PROFILE_MARK(TICK_MARK_MISSION);
+                playing = co_await missionCompleteScreen(loop);
+            } else if (result == TickResult::GAME_OVER) {
+                SNAKE_PROFILE_MARK(TICK_MARK_GAME_OVER);
+                playing = co_await gameOverScreen(loop);
+            } else if (endingRequested) {
+                endingRequested = false;
+                playing = co_await endingScreen(loop);
+            } else {
                 continue;
             }
-
-            // 스네이크가 방향을 가지고 있을 때만 타이머 업데이트 (실제로 움직일 때만)
-            if (gameMap.snakeHeadObject.currentDirection != -1) {
-                updateTimers(growthItemTimer, poisonItemTimer, timeItemTimer);
-                gameTimerSeconds++;
+            if (playing) {
+                captureFrame(screen.writeBuffer());
+                screen.publish();
             }
-
-            usleep(1000 * static_cast<useconds_t>((float)gameSpeedDelay / speedMultiplier));
         }
+        if (telemetry) telemetry->flush();
+        renderer = nullptr;
+        scheduler = nullptr;
     } catch (const std::exception& e) {
+        renderer = nullptr;
+        scheduler = nullptr;
         cleanupNcurses();
         std::cerr << "Game error: " << e.what() << std::endl;
         throw;
     }
 }
 
-void Game::drawBoard(WINDOW* board)
+void Game::pauseRenderer()
 {
-    // Draw immune walls
-    for (const auto& wall : gameMap.immuneWalls) {
-                wattron(board, COLOR_PAIR(2));
-        mvwaddch(board, wall.coord.row, wall.coord.col, '+');
-                wattroff(board, COLOR_PAIR(2));
-            }
-    // Draw regular walls
-    for (const auto& wall : gameMap.regularWalls) {
-                wattron(board, COLOR_PAIR(2));
-        mvwaddch(board, wall.coord.row, wall.coord.col, ' ');
-                wattroff(board, COLOR_PAIR(2));
-            }
-    // Draw snake body (꼬리만 따로 색상)
-    int bodySize = gameMap.snakeHeadObject.snakeBodySegments.size();
-    for (int i = 0; i < bodySize; ++i) {
-        if (i == bodySize-1) {
-            wattron(board, COLOR_PAIR(9)); // 꼬리
-            mvwaddch(board, gameMap.snakeHeadObject.snakeBodySegments[i].coord.row, gameMap.snakeHeadObject.snakeBodySegments[i].coord.col, 'o');
-            wattroff(board, COLOR_PAIR(9));
-        } else {
-                wattron(board, COLOR_PAIR(4));
-            mvwaddch(board, gameMap.snakeHeadObject.snakeBodySegments[i].coord.row, gameMap.snakeHeadObject.snakeBodySegments[i].coord.col, 'O');
-                wattroff(board, COLOR_PAIR(4));
-            }
+    if (renderer) {
+        renderer->stop();
     }
-    // Draw gates
-    for (const auto& gate : gameMap.gameGates) {
-                wattron(board, COLOR_PAIR(7));
-        mvwaddch(board, gate.coord.row, gate.coord.col, ' ');
-                wattroff(board, COLOR_PAIR(7));
-            }
-    // Draw snake head (노란색, 방향 문자)
-    char headChar = '>';
-    switch (gameMap.snakeHeadObject.currentDirection) {
-        case 1: headChar = '^'; break;
-        case 2: headChar = '<'; break;
-        case 3: headChar = '>'; break;
-        case 4: headChar = 'v'; break;
-        default: headChar = 'O'; break;
+}
+
+void Game::captureFrame(FrameSnapshot& frame)
+{
+    const SnakeHead& head = gameMap->snakeHeadObject;
+    frame.tick = tickCount;
+    camera.follow(head.coord);
+    frame.copyRegion(gameMap->occupancy, camera.top(), camera.left(), camera.rows(), camera.cols());
+    frame.head = head.coord;
+    frame.tail = head.snakeBodySegments.empty() ? head.coord : head.snakeBodySegments.back().coord;
+    frame.headDirection = head.currentDirection;
+    frame.stage = currentStage;
+    frame.bodySize = static_cast<int>(head.snakeBodySegments.size());
+    frame.maxSnakeLength = maxSnakeLength;
+    frame.growthCount = growthItemCount;
+    frame.poisonCount = poisonItemCount;
+    frame.gateCount = gatesUsedCount;
+    frame.elapsedSeconds = elapsedSeconds();
+    frame.missionCount = static_cast<int>(missions.goalCount());
+    frame.missionsAchieved = static_cast<int>(missions.achievedGoals());
+    for (int i = 0; i < frame.missionCount && i < FrameSnapshot::MAX_MISSION_LINES; ++i) {
+        const MissionGoal& goal = missions.goal(i);
+        frame.missions[i] = {missionSymbol(goal.metric), goal.target, missions.value(goal.metric), missions.achieved(i)};
     }
-    wattron(board, COLOR_PAIR(3) | A_BOLD);
-    mvwaddch(board, gameMap.snakeHeadObject.coord.row, gameMap.snakeHeadObject.coord.col, headChar);
-    wattroff(board, COLOR_PAIR(3) | A_BOLD);
-    // Draw items
-            wattron(board, COLOR_PAIR(5));
-    mvwaddch(board, gameMap.growthItemObject.coord.row, gameMap.growthItemObject.coord.col, '+');
-            wattroff(board, COLOR_PAIR(5));
-            wattron(board, COLOR_PAIR(6));
-    mvwaddch(board, gameMap.poisonItemObject.coord.row, gameMap.poisonItemObject.coord.col, '-');
-            wattroff(board, COLOR_PAIR(6));
-            wattron(board, COLOR_PAIR(8));
-    mvwaddch(board, gameMap.timeItemObject.coord.row, gameMap.timeItemObject.coord.col, 'T');
-            wattroff(board, COLOR_PAIR(8));
+    frame.soundCues = soundCues;
+    captureMinimap(frame);
+    // 렌더러가 칸 사이 진행 비율을 계산하도록 이동 시각·간격 전달 (멈춰 있으면 보간 안 함)
+    bool moving = scheduler && head.currentDirection >= 1 && head.currentDirection <= 4;
+    frame.moveStart = moving ? scheduler->lastMoveTime(snakeEntity) : std::chrono::steady_clock::time_point();
+    frame.movePeriod = moving ? scheduler->movePeriod(snakeEntity) : std::chrono::steady_clock::duration::zero();
 }
 
-void Game::drawScore(WINDOW* score)
+void Game::captureMinimap(FrameSnapshot& frame) const
 {
-    mvwprintw(score, 1, 1, "*******Score Board*******");
-    mvwprintw(score, 2, 1, " Stage: %d/4", currentStage);
-    mvwprintw(score, 3, 1, " B: %d/%d", gameMap.snakeHeadObject.snakeBodySegments.size(), maxSnakeLength);
-    mvwprintw(score, 4, 1, " +: %d", growthItemCount);
-    mvwprintw(score, 5, 1, " -: %d", poisonItemCount);
-    mvwprintw(score, 6, 1, " G: %d", gatesUsedCount);
-    mvwprintw(score, 7, 1, " time: %d", gameTimerSeconds / (1000 / gameSpeedDelay));
+    frame.minimapRows = frame.minimapCols = 0;
+    if (!camera.showsMinimap() || !minimap.built()) return;
+    // 판에 들어가는 가장 세밀한 단계의 블록만 읽음 (맵 크기와 무관하게 판 크기만큼)
+    int level = minimap.levelFor(FrameSnapshot::MAX_MINIMAP_ROWS, FrameSnapshot::MAX_MINIMAP_COLS);
+    frame.minimapRows = std::min(minimap.blockRows(level), FrameSnapshot::MAX_MINIMAP_ROWS);
+    frame.minimapCols = std::min(minimap.blockCols(level), FrameSnapshot::MAX_MINIMAP_COLS);
+    frame.minimapBlock = minimap.blockSize(level);
+    for (int row = 0; row < frame.minimapRows; ++row) {
+        for (int col = 0; col < frame.minimapCols; ++col) {
+            frame.minimap[row][col] = minimap.glyph(level, row, col);
+        }
+    }
+    int headRow = frame.head.row / frame.minimapBlock;
+    int headCol = frame.head.col / frame.minimapBlock;
+    if (headRow < frame.minimapRows && headCol < frame.minimapCols) {
+        frame.minimap[headRow][headCol] = MinimapGlyph::HEAD;
+    }
 }
 
-void Game::drawMission(WINDOW* mission)
+double Game::snakeSpeed() const
 {
-    mvwprintw(mission, 1, 1, "******Mission Board******");
-    mvwprintw(mission, 2, 1, " Stage %d: %s", currentStage, 
-        currentStage == 1 ? "BASIC" :
-        currentStage == 2 ? "MAZE" :
-        currentStage == 3 ? "ISLANDS" : "CROSS");
-    mvwprintw(mission, 3, 1, " B: 7 / %d (%c) ", gameMap.snakeHeadObject.snakeBodySegments.size(), missionSnakeLengthStatus);
-    mvwprintw(mission, 4, 1, " +: 5 / %d (%c) ", growthItemCount, missionGrowthItemStatus);
-    mvwprintw(mission, 5, 1, " -: 2 / %d (%c) ", poisonItemCount, missionPoisonItemStatus);
-    mvwprintw(mission, 6, 1, " G: 1 / %d (%c) ", gatesUsedCount, missionGateUseStatus);
+    return 1000.0 / gameSpeedDelay * speedMultiplier * options.speedScale;
+}
+
+TickResult Game::tick(int key)
+{
+    // 프레임 아레나는 틱마다 되돌림 (대화형·헤드리스·배치·퍼저 모두 tick()을 거침)
+    frameArena.reset();
+    // 텔레메트리가 붙어 있을 때만 시각을 잼
+    std::chrono::steady_clock::time_point tickStart;
+    if (telemetry) tickStart = std::chrono::steady_clock::now();
+    if (key != ERR) {
+        queueKey(key);
+    }
+    int previousDirection = gameMap->snakeHeadObject.currentDirection;
+    processInput(nextTurn());
+
+    TickResult result = TickResult::RUNNING;
+    if (missions.complete()) {
+        result = TickResult::MISSION_COMPLETE;
+    } else if (!update(previousDirection)) {
+        result = TickResult::GAME_OVER;
+    } else if (gameMap->snakeHeadObject.currentDirection != -1) {
+        // 스네이크가 실제로 움직일 때만 시간 진행 (이번 틱에 만료된 타이머만 처리)
+        timers.advance([this](uint16_t tag, uint32_t data) { onTimer(tag, data); });
+        gameTimerSeconds++;
+    }
+
+    // 이번 틱의 사건을 구독자(점수·미션·관전 서버)에 전달
+    events.dispatch();
+    if (spectator) {
+        spectator->endTick(gameMap->occupancy);
+    }
+    if (telemetry) {
+        int length = static_cast<int>(gameMap->snakeHeadObject.snakeBodySegments.size());
+        telemetry->recordTick(currentStage, length, std::chrono::steady_clock::now() - tickStart);
+        if (result != TickResult::RUNNING) {
+            GameOutcome outcome = result == TickResult::GAME_OVER ? GameOutcome::GAME_OVER : GameOutcome::MISSION_COMPLETE;
+            telemetry->endGame(currentStage, outcome, length, maxSnakeLength, elapsedSeconds());
+        }
+    }
+    if (result != TickResult::RUNNING) {
+        recordScore();
+    }
+    tickCount++;
+    return result;
+}
+
+void Game::attachSpectator(SpectatorServer* server)
+{
+    if (spectator) {
+        events.unsubscribe(spectator);
+    }
+    spectator = server;
+    if (spectator) {
+        events.subscribe(spectator);
+        spectator->requestSnapshot();
+    }
+}
+
+void Game::attachTelemetry(TelemetryWriter* writer)
+{
+    if (telemetry) {
+        events.unsubscribe(telemetry);
+    }
+    telemetry = writer;
+    if (telemetry) {
+        events.subscribe(telemetry);
+        telemetry->beginGame();
+    }
+}
+
+void Game::attachStats(StatsRun* run)
+{
+    if (stats) {
+        events.unsubscribe(stats);
+    }
+    stats = run;
+    if (stats) {
+        events.subscribe(stats);
+    }
+}
+
+Game::StageBoard Game::liveBoard()
+{
+    return StageBoard{*gameMap, freeSpace, freeCells, tracksMinimap() ? &minimap : nullptr, rng, gateCandidates, events};
+}
+
+void Game::emitCell(EventType type, const Coord& pos)
+{
+    StageBoard board = liveBoard();
+    emitCell(board, type, pos);
+}
+
+void Game::emitItem(EventType type, ItemKind kind, const Coord& pos)
+{
+    StageBoard board = liveBoard();
+    emitItem(board, type, kind, pos);
+}
+
+void Game::emitCell(StageBoard& board, EventType type, const Coord& pos)
+{
+    // 칸이 바뀌는 곳은 모두 여기를 지나므로 연결 요소·빈 칸 목록도 여기서 갱신
+    board.freeSpace.refresh(board.map.occupancy, pos);
+    board.freeCells.refresh(board.map.occupancy, pos);
+    if (board.minimap) board.minimap->refresh(board.map.occupancy, pos);
+    board.events.emit(GameEvent::forCell(type, pos, board.map.occupancy.at(pos)));
+}
+
+void Game::emitItem(StageBoard& board, EventType type, ItemKind kind, const Coord& pos)
+{
+    // 아이템 칸은 지나갈 수 있으므로 연결 요소는 그대로, 빈 칸 목록·미니맵만 갱신
+    board.freeCells.refresh(board.map.occupancy, pos);
+    if (board.minimap) board.minimap->refresh(board.map.occupancy, pos);
+    board.events.emit(GameEvent::forItem(type, kind, pos, board.map.occupancy.at(pos)));
+}
+
+bool Game::snakeDoomed() const
+{
+    const SnakeHead& head = gameMap->snakeHeadObject;
+    return freeSpace.doomed(head.coord, gameMap->gameGates, head.snakeBodySegments);
+}
+
+bool Game::gameOver(DeathReason reason)
+{
+    events.emit(GameEvent::forGameOver(reason));
+    return false;
+}
+
+void Game::onEvent(const GameEvent& event)
+{
+    switch (event.type) {
+        case EventType::ITEM_CONSUMED:
+            soundCues++;
+            if (event.item == ItemKind::GROWTH) growthItemCount++;
+            if (event.item == ItemKind::POISON) poisonItemCount++;
+            if (static_cast<int>(gameMap->snakeHeadObject.snakeBodySegments.size()) > maxSnakeLength)
+                maxSnakeLength = static_cast<int>(gameMap->snakeHeadObject.snakeBodySegments.size());
+            break;
+        case EventType::GATE_ENTERED:
+            gatesUsedCount++;
+            break;
+        case EventType::GAME_OVER:
+            deathReason = event.reason;
+            break;
+        default:
+            break;
+    }
+}
+
+int Game::readKey()
+{
+    return options.input ? options.input->readKey() : getch();
+}
+
+void Game::queueKey(int key)
+{
+    bool isDirection = key == KEY_UP || key == KEY_DOWN || key == KEY_LEFT || key == KEY_RIGHT;
+    if (!isDirection) {
+        // 방향키가 아닌 키(디버그 키 등)는 바로 처리
+        processInput(key);
+        return;
+    }
+    // 같은 키 연타는 한 번만 저장, 버퍼가 가득 차면 버림
+    if (turnCount > 0 && turnBuffer[turnCount - 1] == key) return;
+    if (turnCount == TURN_BUFFER_SIZE) return;
+    turnBuffer[turnCount++] = key;
+}
+
+int Game::nextTurn()
+{
+    if (turnCount == 0) return ERR;
+    int key = turnBuffer[0];
+    for (int i = 1; i < turnCount; ++i) {
+        turnBuffer[i - 1] = turnBuffer[i];
+    }
+    turnCount--;
+    return key;
 }
 
 void Game::processInput(int key)
@@ -397,16 +795,12 @@ void Game::processInput(int key)
         // 디버그: D키로 미션 강제 클리어
         case 'd':
         case 'D':
-            growthItemCount = 5;
-            poisonItemCount = 2;
-            gatesUsedCount = 1;
-            gameMap.snakeHeadObject.snakeBodySegments.resize(7);
-            checkMissions();
+            missions.completeAll();
             break;
         // 디버그: E키로 엔딩 바로 보기
         case 'e':
         case 'E':
-            showEndingScreen();
+            if (!options.headless) endingRequested = true;
             break;
         // 디버그: 1~5키로 스테이지 이동
         case '1': case '2': case '3': case '4': case '5':
@@ -417,7 +811,7 @@ void Game::processInput(int key)
     
     // 방향키가 입력된 경우에만 처리
     if (newDirection != -1) {
-        int currentDir = gameMap.snakeHeadObject.currentDirection;
+        int currentDir = gameMap->snakeHeadObject.currentDirection;
         
         // 1. 같은 방향 키 입력은 무시
         if (currentDir == newDirection) {
@@ -436,37 +830,105 @@ void Game::processInput(int key)
             
             if (isOpposite) {
                 // 역방향 이동 시도를 표시하기 위해 특별한 값 설정
-                gameMap.snakeHeadObject.currentDirection = -2; // 역방향 시도 표시
+                gameMap->snakeHeadObject.currentDirection = -2; // 역방향 시도 표시
                 return;
             }
         }
         
         // 3. 유효한 방향 변경
-        gameMap.snakeHeadObject.currentDirection = newDirection;
+        gameMap->snakeHeadObject.currentDirection = newDirection;
     }
 }
 
-void Game::updateTimers(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer)
+void Game::restartTimer(TimerWheel::TimerId& timer, uint32_t delay, TimerTag tag)
 {
-    growthItemTimer++;
-    poisonItemTimer++;
-    timeItemTimer++;
+    timers.cancel(timer);
+    timer = timers.schedule(delay, static_cast<uint16_t>(tag));
+}
 
-    if (speedBoostTimer > 0) {
-        speedBoostTimer--;
-        if (speedBoostTimer == 0) {
-            speedMultiplier = 1;
+void Game::restartRespawn(Cell kind, size_t index)
+{
+    TimerWheel::TimerId& timer = respawnTimers[itemSlot(kind)][index];
+    timers.cancel(timer);
+    timer = scheduleRespawn(timers, kind, index);
+}
+
+TimerWheel::TimerId Game::scheduleRespawn(TimerWheel& wheel, Cell kind, size_t index)
+{
+    return wheel.schedule(ITEM_RESPAWN_TICKS,
+                          static_cast<uint16_t>(static_cast<int>(TimerTag::GROWTH_RESPAWN) + itemSlot(kind)),
+                          static_cast<uint32_t>(index));
+}
+
+int Game::itemSlot(Cell kind)
+{
+    switch (kind) {
+        case Cell::GROWTH: return 0;
+        case Cell::POISON: return 1;
+        case Cell::TIME:   return 2;
+        default: throw std::invalid_argument("Not an item cell");
+    }
+}
+
+ItemKind Game::itemKindOf(Cell kind)
+{
+    switch (kind) {
+        case Cell::POISON: return ItemKind::POISON;
+        case Cell::TIME:   return ItemKind::TIME;
+        default:           return ItemKind::GROWTH;
+    }
+}
+
+void Game::onTimer(uint16_t tag, uint32_t data)
+{
+    static const Cell respawnKinds[3] = {Cell::GROWTH, Cell::POISON, Cell::TIME};
+    switch (static_cast<TimerTag>(tag)) {
+        case TimerTag::GROWTH_RESPAWN:
+        case TimerTag::POISON_RESPAWN:
+        case TimerTag::TIME_RESPAWN: {
+            Cell kind = respawnKinds[tag - static_cast<uint16_t>(TimerTag::GROWTH_RESPAWN)];
+            if (data >= gameMap->itemCount(kind)) break;
+            respawnTimers[itemSlot(kind)][data] = TimerWheel::NO_TIMER;
+            spawnItem(kind, data);
+            restartRespawn(kind, data);
+            break;
         }
+        case TimerTag::SPEED_BOOST_END:
+            speedBoostTimer = TimerWheel::NO_TIMER;
+            speedMultiplier = 1;
+            break;
+        case TimerTag::GATE_EXPIRE:
+            gateExpiryTimer = TimerWheel::NO_TIMER;
+            for (auto& gate : gameMap->gameGates) gate.isActive = false;
+            break;
     }
 }
 
-void Game::handleGameOver()
+void Game::recordScore()
 {
+    lastRank = lastRankOf = 0;
+    if (!highScores) return;
+    try {
+        highScores->append(static_cast<uint32_t>(maxSnakeLength), currentStage, getMapTypeForStage(currentStage));
+        HighScoreStore::BoardId board = HighScoreStore::stageBoard(currentStage);
+        lastRank = highScores->rank(board, static_cast<uint32_t>(maxSnakeLength));
+        lastRankOf = highScores->size(board);
+    } catch (const std::exception&) {
+        // 디스크 오류 등으로 기록하지 못해도 게임은 계속 (화면에 순위만 표시하지 않음)
+        lastRank = lastRankOf = 0;
+    }
+}
+
+UiTask<bool> Game::gameOverScreen(UiLoop& loop)
+{
+    pauseRenderer();
     try {
         int reason_max_width = 22;
-        std::string reason = gameOverReason;
-        std::vector<std::string> reason_lines;
-        std::string prefix = "Reason: ";
+        std::string_view reason = describe(deathReason);
+        // 줄 목록은 원인 문자열을 가리키는 view로만 구성 (프레임 아레나 사용)
+        std::pmr::vector<std::string_view> reason_lines(&frameArena);
+        bool reason_truncated = false;
+        std::string_view prefix = "Reason: ";
         size_t prefix_len = prefix.length();
         size_t pos = 0;
         if (reason.length() <= reason_max_width - prefix_len) {
@@ -484,23 +946,31 @@ void Game::handleGameOver()
             size_t len = line.length();
             if (max_line_len < len) max_line_len = len;
         }
-        int min_width = 27;
+        // 점수 저장소에 기록됐으면 스테이지 내 순위 한 줄 추가
+        char rank_text[48] = "";
+        int rank_lines = 0;
+        if (lastRank > 0) {
+            std::snprintf(rank_text, sizeof(rank_text), "Rank: #%llu of %llu",
+                          (unsigned long long)lastRank, (unsigned long long)lastRankOf);
+            rank_lines = 1;
+        }
+        int min_width = std::max(27, (int)std::strlen(rank_text) + 6);
         int term_rows, term_cols;
         getmaxyx(stdscr, term_rows, term_cols);
         int win_width = std::max(min_width, (int)max_line_len + 10);
         if (win_width > term_cols - 2) win_width = term_cols - 2;
-        // 세로 크기: 위여백(2) + 제목(1) + 여백(1) + 스테이지(1) + 여백(1) + Reason(줄수) + 여백(1) + 점수(1) + 여백(1) + 안내문구(2) + 아래여백(1)
-        int win_height = 2 + 1 + 1 + 1 + 1 + (int)reason_lines.size() + 1 + 1 + 1 + 2 + 1;
+        // 세로 크기: 위여백(2) + 제목(1) + 여백(1) + 스테이지(1) + 여백(1) + Reason(줄수) + 여백(1) + 점수(1) + 순위(0~1) + 여백(1) + 안내문구(2) + 아래여백(1)
+        int win_height = 2 + 1 + 1 + 1 + 1 + (int)reason_lines.size() + 1 + 1 + rank_lines + 1 + 2 + 1;
         if (win_height > term_rows) {
             win_height = term_rows;
-            int max_reason_lines = win_height - (2+1+1+1+1+1+1+2+1);
+            int max_reason_lines = win_height - (2+1+1+1+1+1+1+2+1) - rank_lines;
             if (max_reason_lines < 0) max_reason_lines = 0;
             if ((int)reason_lines.size() > max_reason_lines) {
                 reason_lines.resize(max_reason_lines);
                 if (!reason_lines.empty()) {
-                    std::string& last = reason_lines.back();
-                    if (last.length() > 3) last.replace(last.length()-3, 3, "...");
-                    else last += "...";
+                    std::string_view& last = reason_lines.back();
+                    if (last.length() > 3) last.remove_suffix(3);
+                    reason_truncated = true;
                 }
             }
         }
@@ -509,7 +979,7 @@ void Game::handleGameOver()
         int margin = 2;
         int win_starty = mission_starty + mission_height + margin;
         if (win_starty + win_height > term_rows) win_starty = std::max(0, term_rows - win_height);
-        int win_startx = gameMap.mapSize.width + 4;
+        int win_startx = camera.panelColumn();
         if (win_startx + win_width > term_cols) win_startx = std::max(0, term_cols - win_width);
         
         WindowWrapper score(win_height, win_width, win_starty, win_startx);
@@ -523,29 +993,30 @@ void Game::handleGameOver()
             mvwprintw(score.get(), y++, 4, "Stage: %d", currentStage);
             y++; // 여백
             for (size_t i = 0; i < reason_lines.size(); ++i) {
+                const char* ellipsis = (reason_truncated && i + 1 == reason_lines.size()) ? "..." : "";
                 if (i == 0)
-                    mvwprintw(score.get(), y++, 4, "Reason: %s", reason_lines[i].c_str());
+                    mvwprintw(score.get(), y++, 4, "Reason: %.*s%s", (int)reason_lines[i].length(), reason_lines[i].data(), ellipsis);
                 else
-                    mvwprintw(score.get(), y++, 4, "        %s", reason_lines[i].c_str());
+                    mvwprintw(score.get(), y++, 4, "        %.*s%s", (int)reason_lines[i].length(), reason_lines[i].data(), ellipsis);
             }
             y++; // 여백
             mvwprintw(score.get(), y++, 4, "Score: %d", maxSnakeLength);
+            if (rank_lines > 0) mvwprintw(score.get(), y++, 4, "%s", rank_text);
             y++; // 여백
             // 안내문구를 박스의 마지막에서 3, 2번째 줄에 위치
             mvwprintw(score.get(), win_height-3, 4, "Press 'P' to retry");
             mvwprintw(score.get(), win_height-2, 4, "Press 'E' to exit");
             wrefresh(score.get());
 
-            char key = getch();
+            int key = co_await loop.nextKey();
             if (key == 'e') {
-                cleanupNcurses();
-                exit(0);
+                SNAKE_PROFILE_DUMP("game_over");
+                co_return false;
             }
             if (key == 'p') {
                 resetCurrentStage();
-                break;
+                co_return true;
             }
-            usleep(100000);
         }
     } catch (const std::exception& e) {
         cleanupNcurses();
@@ -554,10 +1025,13 @@ void Game::handleGameOver()
     }
 }
 
-void Game::handleMissionComplete()
+UiTask<bool> Game::missionCompleteScreen(UiLoop& loop)
 {
+    pauseRenderer();
+    // 플레이어가 화면을 보는 동안 다음 스테이지를 미리 만들어 둠 (마지막 스테이지 다음은 1)
+    startStagePrep(currentStage % STAGE_COUNT + 1);
     try {
-        WindowWrapper score(9, 27, 0, gameMap.mapSize.width + 4);
+        WindowWrapper score(9, 27, 0, camera.panelColumn());
         
         while (true) {
             wclear(score.get());
@@ -570,106 +1044,196 @@ void Game::handleMissionComplete()
             mvwprintw(score.get(), 7, 2, "Press 'E' to exit");
             wrefresh(score.get());
 
-            char key = getch();
+            int key = co_await loop.nextKey();
             if (key == 'e') {
-                cleanupNcurses();
-                exit(0);
+                co_return false;
             }
             if (key == 'p') {
-                goToNextStage();
                 break;
             }
-            usleep(100000);
         }
     } catch (const std::exception& e) {
         cleanupNcurses();
         std::cerr << "Mission Complete screen error: " << e.what() << std::endl;
         throw;
     }
+    // 마지막 스테이지였으면 엔딩 화면 (catch 안에서는 co_await 불가하므로 try 밖에서)
+    if (currentStage == STAGE_COUNT && !co_await endingScreen(loop)) {
+        co_return false;
+    }
+    goToNextStage();
+    co_return true;
+}
+
+void Game::newGame(unsigned int seed, int itemsPerType)
+{
+    // 이전 판에서 남은 사건은 이전 상태에 전달하고 끝냄
+    events.dispatch();
+    options.seed = seed;
+    options.itemsPerType = itemsPerType;
+    rng.seed(seed ? seed : static_cast<unsigned int>(time(nullptr)));
+    currentStage = 1;
+    deathReason = DeathReason::NONE;
+    tickCount = 0;
+    soundCues = 0;
+    endingRequested = false;
+    // 이전 게임 난수로 준비해 둔 스테이지는 버림
+    joinStagePrep();
+    prep.stage = 0;
+    prep.error = nullptr;
+    resetCurrentStage();
 }
 
 void Game::resetCurrentStage()
 {
-    gameMap = Map(21, 41, rand() % 4 + 2, getMapTypeForStage(currentStage), currentStage);
-    gateActiveDuration = 0;
+    loadStageLayout();
+    SNAKE_PROFILE_MARK(TICK_MARK_STAGE_RESET);
+    if (spectator) spectator->requestSnapshot();
+    if (telemetry) telemetry->beginGame();
     growthItemCount = 0;
     poisonItemCount = 0;
     gatesUsedCount = 0;
     maxSnakeLength = 3;
     gameTimerSeconds = 0;
     speedMultiplier = 1;
-    
-    // 아이템 타이머들 초기화
-    growthItemTimer = 0;
-    poisonItemTimer = 0;
-    timeItemTimer = 0;
-    
-    missionSnakeLengthStatus = ' ';
-    missionGrowthItemStatus = ' ';
-    missionPoisonItemStatus = ' ';
-    missionGateUseStatus = ' ';
-    allMissionsCompleted = false;
-    generateItems();
-    generateGate();
+    turnCount = 0;
+    emitPreparedEvents();
     
     // 모든 스테이지에서 동일한 속도 (0.2초 = 200ms)
     gameSpeedDelay = 200;
 }
 
+void Game::loadStageLayout()
+{
+    joinStagePrep();
+    if (prep.error) {
+        std::rethrow_exception(std::exchange(prep.error, nullptr));
+    }
+    if (prep.stage != currentStage) {
+        prepareStage(currentStage, rng());
+    }
+    // 슬롯 교체: Map은 포인터만, 색인·타이머·미션은 같은 메모리 자원의 벡터끼리 swap이라 맵 크기·아이템 수와 무관
+    activeSlot = 1 - activeSlot;
+    gameMap = &*stageMaps[activeSlot];
+    std::swap(freeSpace, prep.freeSpace);
+    std::swap(freeCells, prep.freeCells);
+    if (tracksMinimap()) {
+        // 준비할 때 미니맵을 집계하지 않았으면 (그사이 미니맵이 켜짐) 여기서 한 번 집계
+        if (!prep.trackedMinimap) prep.minimap.rebuild(gameMap->occupancy);
+        std::swap(minimap, prep.minimap);
+    }
+    std::swap(timers, prep.timers);
+    for (int slot = 0; slot < 3; ++slot) respawnTimers[slot].swap(prep.respawnTimers[slot]);
+    speedBoostTimer = TimerWheel::NO_TIMER;
+    gateExpiryTimer = TimerWheel::NO_TIMER;
+    missions.swap(prep.missions);
+    prep.stage = 0;
+    camera.center(gameMap->snakeHeadObject.coord);
+}
+
+void Game::prepareStage(int stage, uint32_t seed)
+{
+    std::optional<Map>& layout = stageLayouts[(stage - 1) % STAGE_COUNT];
+    if (!layout) {
+        layout.emplace(options.mapHeight, options.mapWidth, 0, getMapTypeForStage(stage), stage, &layoutArena);
+    }
+    // 대기 슬롯의 이전 Map을 파괴한 뒤 아레나를 통째로 되돌리고 같은 메모리에 레이아웃 복사
+    int slot = 1 - activeSlot;
+    stageMaps[slot].reset();
+    stageArenas[slot].reset();
+    Map& map = stageMaps[slot].emplace(*layout, &stageArenas[slot]);
+    prep.freeSpace.rebuild(map.occupancy);
+    prep.freeCells.rebuild(map.occupancy);
+    prep.trackedMinimap = tracksMinimap();
+    if (prep.trackedMinimap) prep.minimap.rebuild(map.occupancy);
+
+    // 미션 → 아이템 → 게이트 → 재생성 타이머 순 (사건은 prep.deferred에 쌓였다가 전환 때 발행)
+    prep.rng.seed(seed);
+    prep.deferred.events.clear();
+    prep.missions.load(stageMissions(stage), static_cast<int>(map.snakeHeadObject.snakeBodySegments.size()));
+    StageBoard board{map, prep.freeSpace, prep.freeCells, prep.trackedMinimap ? &prep.minimap : nullptr,
+                     prep.rng, prep.gateCandidates, prep.queue};
+    placeItems(board);
+    placeGates(board);
+    prep.timers.reset();
+    for (Cell kind : {Cell::GROWTH, Cell::POISON, Cell::TIME}) {
+        auto& slotTimers = prep.respawnTimers[itemSlot(kind)];
+        slotTimers.assign(map.itemCount(kind), TimerWheel::NO_TIMER);
+        for (size_t i = 0; i < slotTimers.size(); ++i) slotTimers[i] = scheduleRespawn(prep.timers, kind, i);
+    }
+    prep.queue.dispatch();
+    prep.stage = stage;
+}
+
+void Game::startStagePrep(int stage)
+{
+    joinStagePrep();
+    prep.stage = 0;
+    prep.error = nullptr;
+    // 스테이지 난수는 여기서(틱 스레드) 갈라내므로 그 자리에서 준비할 때와 같은 순서로 난수를 씀
+    uint32_t seed = rng();
+    prep.worker = std::thread([this, stage, seed] {
+        try {
+            prepareStage(stage, seed);
+        } catch (...) {
+            prep.error = std::current_exception();
+        }
+    });
+}
+
+void Game::joinStagePrep()
+{
+    if (prep.worker.joinable()) prep.worker.join();
+}
+
+void Game::emitPreparedEvents()
+{
+    for (const GameEvent& event : prep.deferred.events) events.emit(event);
+    prep.deferred.events.clear();
+}
+
 void Game::goToNextStage()
 {
+    // 미션 완료 화면을 거쳤으면 다음 스테이지가 이미 대기 슬롯에 있으므로 교체만 함
     currentStage++;
-    if(currentStage > 4) {
-        showEndingScreen();
+    // 엔딩 화면은 미션 완료 화면이 먼저 보여 줌
+    if(currentStage > STAGE_COUNT) {
         currentStage = 1;
     }
     resetCurrentStage();
 }
 
-void Game::checkMissions()
-{
-    missionSnakeLengthStatus = (gameMap.snakeHeadObject.snakeBodySegments.size() >= 7) ? 'v' : ' ';
-    missionGrowthItemStatus = (growthItemCount >= 5) ? 'v' : ' ';
-    missionPoisonItemStatus = (poisonItemCount >= 2) ? 'v' : ' ';
-    missionGateUseStatus = (gatesUsedCount >= 1) ? 'v' : ' ';
-
-    allMissionsCompleted = (missionSnakeLengthStatus == 'v' && 
-                          missionGrowthItemStatus == 'v' && 
-                          missionPoisonItemStatus == 'v' && 
-                          missionGateUseStatus == 'v');
-}
-
-bool Game::update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer, int previousDirection)
+bool Game::update(int previousDirection)
 {
     // 먼저 역방향 이동 검사
-    if (gameMap.snakeHeadObject.currentDirection == -2) {
-        return false; // 게임 종료
+    if (gameMap->snakeHeadObject.currentDirection == -2) {
+        return gameOver(DeathReason::OPPOSITE_DIRECTION);
     }
     
-    if (gateActiveDuration == 0)
+    Coord previousHead = gameMap->snakeHeadObject.coord;
+    bool moving = gameMap->snakeHeadObject.currentDirection != -1;
+    if (moving)
     {
-        gameMap.gameGates[0].isActive = false;
-        gameMap.gameGates[1].isActive = false;
+        gameMap->snakeHeadObject.snakeBodySegments.insert(gameMap->snakeHeadObject.snakeBodySegments.begin(), SnakeBody(gameMap->snakeHeadObject));
+        Coord tail = gameMap->snakeHeadObject.snakeBodySegments.back().coord;
+        gameMap->occupancy.leaveSnake(tail);
+        gameMap->snakeHeadObject.snakeBodySegments.pop_back();
+        emitCell(EventType::TAIL_VACATED, tail);
     }
-    else
-        gateActiveDuration--;
-    if (gameMap.snakeHeadObject.currentDirection != -1)
+    gameMap->snakeHeadObject.move();
+    for (size_t i = 0; i < gameMap->gameGates.size(); i++)
     {
-        gameMap.snakeHeadObject.snakeBodySegments.insert(gameMap.snakeHeadObject.snakeBodySegments.begin(), SnakeBody(gameMap.snakeHeadObject));
-        gameMap.snakeHeadObject.snakeBodySegments.pop_back();
-    }
-    gameMap.snakeHeadObject.move();
-    for (size_t i = 0; i < gameMap.gameGates.size(); i++)
-    {
-        auto it = gameMap.gameGates.begin() + i;
-        if (it->coord == gameMap.snakeHeadObject.coord)
+        auto it = gameMap->gameGates.begin() + i;
+        if (it->coord == gameMap->snakeHeadObject.coord)
         {
             it->isActive = true;
-            gateActiveDuration = static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size());
-            auto other = (i == 0 ? gameMap.gameGates.begin() + 1 : gameMap.gameGates.begin());
+            emitCell(EventType::GATE_ENTERED, it->coord);
+            // 몸통 전체가 게이트를 빠져나갈 때까지 활성 상태 유지
+            restartTimer(gateExpiryTimer, static_cast<uint32_t>(gameMap->snakeHeadObject.snakeBodySegments.size()) + 1, TimerTag::GATE_EXPIRE);
+            auto other = (i == 0 ? gameMap->gameGates.begin() + 1 : gameMap->gameGates.begin());
             if (other->exitDirection == 6)
             {
-                int inDir = gameMap.snakeHeadObject.currentDirection;
+                int inDir = gameMap->snakeHeadObject.currentDirection;
                 int dirPriority[4];
                 dirPriority[0] = inDir; // 진입 방향과 일치하는 방향
                 // 반시계 방향 (시계 반대방향)
@@ -688,289 +1252,219 @@ bool Game::update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer
                         case 4: tmp.row++; break;
                     }
                     bool blocked = false;
-                    for (auto w = gameMap.regularWalls.begin(); w != gameMap.regularWalls.end(); w++) {
+                    for (auto w = gameMap->regularWalls.begin(); w != gameMap->regularWalls.end(); w++) {
                         if (w->coord == tmp) { blocked = true; break; }
                     }
                     if (!blocked) {
-                        gameMap.snakeHeadObject.currentDirection = d;
+                        gameMap->snakeHeadObject.currentDirection = d;
                         break;
                     }
                 }
             }
             else
             {
-                gameMap.snakeHeadObject.currentDirection = other->exitDirection;
+                gameMap->snakeHeadObject.currentDirection = other->exitDirection;
             }
-            gameMap.snakeHeadObject.coord = other->coord;
-            gameMap.snakeHeadObject.move();
-            gatesUsedCount++;
+            gameMap->snakeHeadObject.coord = other->coord;
+            gameMap->snakeHeadObject.move();
         }
     }
 
-    // 아이템 5초(50틱)마다 자동 재생성
-    if (growthItemTimer >= 50) { generateGItem(); growthItemTimer = 0; }
-    if (poisonItemTimer >= 50) { generatePItem(); poisonItemTimer = 0; }
-    if (timeItemTimer >= 50) { generateTItem(); timeItemTimer = 0; }
-
-    if (gameMap.snakeHeadObject.coord == gameMap.growthItemObject.coord)
-    {
-        beep();
-        growthItemCount++;
-        generateGItem();
-        growthItemTimer = 0;
-        safeAddSnakeBody();
+    // 이동이 끝난 뒤 점유 격자에 머리/몸통 반영 (이전 머리 칸은 첫 번째 몸통 마디가 됨)
+    if (moving) {
+        gameMap->occupancy.relabelSnake(previousHead, Cell::BODY);
+        gameMap->occupancy.enterSnake(gameMap->snakeHeadObject.coord, Cell::HEAD);
+        emitCell(EventType::CELL_CHANGED, previousHead);
+        emitCell(EventType::HEAD_MOVED, gameMap->snakeHeadObject.coord);
     }
-    if (gameMap.snakeHeadObject.coord == gameMap.poisonItemObject.coord)
+
+    // 아이템 자동 재생성(50틱)은 타이머 휠이 처리 (onTimer)
+
+    // 머리 칸의 아이템은 칸 색인으로 바로 찾음 (아이템 수와 무관하게 O(1))
+    Coord headPos = gameMap->snakeHeadObject.coord;
+    int eatenIndex = gameMap->itemAt(headPos);
+    if (eatenIndex >= 0)
     {
-        beep();
-        poisonItemCount++;
-        generatePItem();
-        poisonItemTimer = 0;
-        if (!safeRemoveSnakeBody()) {
-            gameOverReason = "Length is less than 3.";
-            return false;
+        Cell kind = gameMap->occupancy.groundAt(headPos);
+        size_t index = static_cast<size_t>(eatenIndex);
+        emitItem(EventType::ITEM_CONSUMED, itemKindOf(kind), headPos);
+        switch (kind) {
+            case Cell::GROWTH:
+                // 꼬리를 먼저 늘려야 새 아이템이 늘어난 꼬리 칸에 생성되지 않음
+                safeAddSnakeBody();
+                spawnItem(kind, index);
+                restartRespawn(kind, index);
+                break;
+            case Cell::POISON:
+                spawnItem(kind, index);
+                restartRespawn(kind, index);
+                if (!safeRemoveSnakeBody()) {
+                    return gameOver(DeathReason::TOO_SHORT);
+                }
+                break;
+            case Cell::TIME:
+                spawnItem(kind, index);
+                restartRespawn(kind, index);
+                speedMultiplier = 1.5;
+                restartTimer(speedBoostTimer, SPEED_BOOST_TICKS, TimerTag::SPEED_BOOST_END);
+                break;
+            default:
+                break;
         }
     }
-    if (gameMap.snakeHeadObject.coord == gameMap.timeItemObject.coord)
-    {
-        beep();
-        generateTItem();
-        timeItemTimer = 0;
-        speedMultiplier = 1.5;
-        speedBoostTimer = 40;
-    }
-
-    // mission
-    checkMissions();
-
-    // allMissionsCompleted
-    if (static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size()) > maxSnakeLength)
-        maxSnakeLength = static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size());
 
+    // 점수·미션은 틱 끝에 사건을 받아 갱신 (onEvent)
     return isValid(previousDirection);
 }
 
 bool Game::isValid(int /*previousDirection*/)
 {
     // 역방향 이동 시도 검사
-    if (gameMap.snakeHeadObject.currentDirection == -2) {
-        gameOverReason = "Tried moving in the opposite direction.";
-        return false;
+    if (gameMap->snakeHeadObject.currentDirection == -2) {
+        return gameOver(DeathReason::OPPOSITE_DIRECTION);
     }
     
     // 벽과의 충돌 검사 (머리와 몸통 모두)
-    for (auto it = gameMap.regularWalls.begin(); it != gameMap.regularWalls.end(); it++)
+    // 일반 벽·게이트 칸은 점유 격자 바닥 층에 WALL/GATE로 있으므로 벽 목록을 훑지 않고 칸마다 O(1)
+    const OccupancyGrid& grid = gameMap->occupancy;
+    auto inWall = [&grid](const Coord& pos) {
+        Cell ground = grid.groundAt(pos);
+        return ground == Cell::WALL || ground == Cell::GATE;
+    };
+    if (inWall(gameMap->snakeHeadObject.coord))
     {
-        if (it->coord == gameMap.snakeHeadObject.coord)
-        {
-            gameOverReason = "Collided with the wall.";
-            return false;
-        }
-        for (auto body = gameMap.snakeHeadObject.snakeBodySegments.begin(); body != gameMap.snakeHeadObject.snakeBodySegments.end(); body++)
+        return gameOver(DeathReason::WALL);
+    }
+    for (auto body = gameMap->snakeHeadObject.snakeBodySegments.begin(); body != gameMap->snakeHeadObject.snakeBodySegments.end(); body++)
+    {
+        if (inWall(body->coord))
         {
-            if (it->coord == body->coord)
-            {
-                gameOverReason = "Snake body overlapped with wall.";
-                return false;
-            }
+            return gameOver(DeathReason::BODY_IN_WALL);
         }
     }
-    for (auto it = gameMap.snakeHeadObject.snakeBodySegments.begin(); it != gameMap.snakeHeadObject.snakeBodySegments.end(); it++)
+    for (auto it = gameMap->snakeHeadObject.snakeBodySegments.begin(); it != gameMap->snakeHeadObject.snakeBodySegments.end(); it++)
     {
-        if (it->coord == gameMap.snakeHeadObject.coord)
+        if (it->coord == gameMap->snakeHeadObject.coord)
         {
-            gameOverReason = "Collided with the body.";
-            return false;
+            return gameOver(DeathReason::SELF);
         }
     }
-    if (gameMap.snakeHeadObject.snakeBodySegments.size() < 3)
+    if (gameMap->snakeHeadObject.snakeBodySegments.size() < 3)
     {
-        gameOverReason = "Length is less than 3.";
-        return false;
+        return gameOver(DeathReason::TOO_SHORT);
     }
     return true;
 }
 
-void Game::generateRandCoord(int &row, int &col, bool shouldIncludeWall)
-    {
-        while (1)
-        {
-        row = rand() % (gameMap.mapSize.height - 1) + 2;
-        col = rand() % (gameMap.mapSize.width - 1) + 2;
-            Coord tmp;
-        tmp.row = row;
-        tmp.col = col;
-            bool same = false;
-            if (!shouldIncludeWall)
-            {
-            for (auto it = gameMap.regularWalls.begin(); it != gameMap.regularWalls.end(); it++)
-            {
-                if (it->coord == tmp)
-                    same = true;
-            }
-        }
-        for (auto it = gameMap.snakeHeadObject.snakeBodySegments.begin(); it != gameMap.snakeHeadObject.snakeBodySegments.end(); it++)
-            {
-                if (it->coord == tmp)
-                    same = true;
-            }
-        for (auto it = gameMap.gameGates.begin(); it != gameMap.gameGates.end(); it++)
-        {
-            if (it->coord == tmp)
-                same = true;
-        }
-        if (gameMap.snakeHeadObject.coord == tmp)
-            same = true;
-        if (gameMap.growthItemObject.coord == tmp)
-                same = true;
-        if (gameMap.poisonItemObject.coord == tmp)
-                same = true;
-        // 아이템이 벽에 갇히지 않도록 상하좌우가 모두 벽이 아닌지 체크
-        bool surrounded = false;
-        int dr[4] = {-1, 1, 0, 0};
-        int dc[4] = {0, 0, -1, 1};
-        int wallCount = 0;
-        for (int d = 0; d < 4; ++d) {
-            Coord adj{row + dr[d], col + dc[d]};
-            for (auto it = gameMap.regularWalls.begin(); it != gameMap.regularWalls.end(); it++) {
-                if (it->coord == adj) wallCount++;
-            }
-        }
-        if (wallCount == 4) surrounded = true;
-        if (!same && !surrounded)
-            break;
-    }
+bool Game::generateRandCoord(int &row, int &col)
+{
+    StageBoard board = liveBoard();
+    Coord pos;
+    if (!pickItemCell(board, pos)) return false;
+    row = pos.row;
+    col = pos.col;
+    return true;
 }
 
 void Game::generateGate()
 {
+    StageBoard board = liveBoard();
+    SNAKE_PROFILE_MARK(TICK_MARK_GATE_REGEN);
+    placeGates(board);
+}
+
+void Game::generateItems()
+{
+    StageBoard board = liveBoard();
+    placeItems(board);
+}
+
+void Game::spawnItem(Cell kind, size_t index)
+{
+    StageBoard board = liveBoard();
+    SNAKE_PROFILE_MARK(TICK_MARK_ITEM_SPAWN);
+    placeItem(board, kind, index);
+}
+
+bool Game::pickItemCell(StageBoard& board, Coord& pos)
+{
+    // 빈 칸 목록에서만 고르므로 판이 거의 차도 최악 O(빈 칸 수)
+    // 머리에서 닿는 연결 요소 안의 칸을 우선 (갇힌 공간에 아이템이 생기지 않게)
+    ReachabilityMap::ReachableSet reachable = board.freeSpace.reachableFrom(board.map.snakeHeadObject.coord, board.map.gameGates);
+    return pickSpawnCell(board.map.occupancy, board.freeCells, board.freeSpace, reachable, board.rng, pos);
+}
+
+void Game::placeGates(StageBoard& board)
+{
+    Map& map = board.map;
     int wallIndex1, wallIndex2;
-    
-    // 게이트로 사용 가능한 벽인지 확인하는 함수
-    auto isGateWallValid = [&](const Wall& wall) {
-        // 1. 맵 경계에서 너무 가까운 곳은 제외 (모서리 근처)
-        if (wall.coord.row <= 2 || wall.coord.row >= gameMap.mapSize.height - 1 ||
-            wall.coord.col <= 2 || wall.coord.col >= gameMap.mapSize.width - 1) {
-            return false;
-        }
-        
-        // 2. 상하좌우 중 최소 2방향이 빈 공간이어야 함 (진출로 확보)
-        int dr[4] = {-1, 1, 0, 0};
-        int dc[4] = {0, 0, -1, 1};
-        int openDirections = 0;
-        
-        for (int d = 0; d < 4; ++d) {
-            Coord adj{wall.coord.row + dr[d], wall.coord.col + dc[d]};
-            
-            // 벽이 아니고 맵 범위 내인지 확인
-            bool isWall = false;
-            for (const auto& w : gameMap.regularWalls) {
-                if (w.coord == adj) { 
-                    isWall = true; 
-                    break; 
-                }
-            }
-            for (const auto& w : gameMap.immuneWalls) {
-                if (w.coord == adj) { 
-                    isWall = true; 
-                    break; 
-                }
-            }
-            
-            // 빈 공간이고 맵 범위 내라면 진출 가능한 방향
-            if (!isWall && adj.row > 1 && adj.row < gameMap.mapSize.height && 
-                adj.col > 1 && adj.col < gameMap.mapSize.width) {
-                openDirections++;
+
+    // 후보 선정은 Map이 담당 (오프라인 레벨 검증과 같은 기준)
+    std::pmr::vector<int>& candidates = board.gateCandidates;
+    candidates.reserve(map.regularWalls.size());
+    if (map.gateCandidates(candidates)) {
+        wallIndex1 = candidates[board.rng() % candidates.size()];
+        do {
+            wallIndex2 = candidates[board.rng() % candidates.size()];
+        } while (wallIndex1 == wallIndex2);
+    } else {
+        // 최후의 수단: 테두리가 아닌 아무 벽이나 선택
+        // 후보를 먼저 모아 고르므로 그런 벽이 모자라도 끝없이 돌지 않음
+        candidates.clear();
+        for (size_t i = 0; i < map.regularWalls.size(); ++i) {
+            const Coord& pos = map.regularWalls[i].coord;
+            if (pos.row > 1 && pos.row < map.mapSize.height && pos.col > 1 && pos.col < map.mapSize.width) {
+                candidates.push_back((int)i);
             }
         }
-        
-        // 최소 2방향 이상 진출 가능해야 함 (진출로가 전혀 없는 공간 방지)
-        return openDirections >= 2;
-    };
-    
-    // 유효한 벽들만 필터링
-    vector<int> validWallIndices;
-    for (size_t i = 0; i < gameMap.regularWalls.size(); ++i) {
-        if (isGateWallValid(gameMap.regularWalls[i])) {
-            validWallIndices.push_back(static_cast<int>(i));
-        }
-    }
-    
-    // 유효한 벽이 2개 이상 있어야 게이트 생성 가능
-    if (validWallIndices.size() < 2) {
-        // 유효한 벽이 부족하면 기본적으로 테두리 벽 중에서 선택
-        vector<int> borderWalls;
-        for (size_t i = 0; i < gameMap.regularWalls.size(); ++i) {
-            const Wall& wall = gameMap.regularWalls[i];
-            // 테두리 벽 중에서 모서리가 아닌 곳만 선택
-            if ((wall.coord.row == 1 && wall.coord.col > 3 && wall.coord.col < gameMap.mapSize.width - 2) ||
-                (wall.coord.row == gameMap.mapSize.height && wall.coord.col > 3 && wall.coord.col < gameMap.mapSize.width - 2) ||
-                (wall.coord.col == 1 && wall.coord.row > 3 && wall.coord.row < gameMap.mapSize.height - 2) ||
-                (wall.coord.col == gameMap.mapSize.width && wall.coord.row > 3 && wall.coord.row < gameMap.mapSize.height - 2)) {
-                borderWalls.push_back(static_cast<int>(i));
-            }
+        if (candidates.size() < 2) {
+            // 안쪽 벽이 모자라면 테두리 벽까지
+            candidates.resize(map.regularWalls.size());
+            for (size_t i = 0; i < candidates.size(); ++i) candidates[i] = (int)i;
         }
-        
-        if (borderWalls.size() >= 2) {
-            wallIndex1 = borderWalls[rand() % borderWalls.size()];
-            do {
-                wallIndex2 = borderWalls[rand() % borderWalls.size()];
-            } while (wallIndex1 == wallIndex2);
-        } else {
-            // 최후의 수단: 아무 벽이나 선택 (모서리 제외)
-            do {
-                wallIndex1 = rand() % gameMap.regularWalls.size();
-            } while (gameMap.regularWalls[wallIndex1].coord.row <= 1 || 
-                     gameMap.regularWalls[wallIndex1].coord.row >= gameMap.mapSize.height ||
-                     gameMap.regularWalls[wallIndex1].coord.col <= 1 || 
-                     gameMap.regularWalls[wallIndex1].coord.col >= gameMap.mapSize.width);
-            
-            do {
-                wallIndex2 = rand() % gameMap.regularWalls.size();
-            } while (wallIndex1 == wallIndex2 ||
-                     gameMap.regularWalls[wallIndex2].coord.row <= 1 || 
-                     gameMap.regularWalls[wallIndex2].coord.row >= gameMap.mapSize.height ||
-                     gameMap.regularWalls[wallIndex2].coord.col <= 1 || 
-                     gameMap.regularWalls[wallIndex2].coord.col >= gameMap.mapSize.width);
+        if (candidates.size() < 2) {
+            throw std::runtime_error("No walls left to place gates on");
         }
-    } else {
-        // 유효한 벽들 중에서 랜덤 선택
-        wallIndex1 = validWallIndices[rand() % validWallIndices.size()];
-        do {
-            wallIndex2 = validWallIndices[rand() % validWallIndices.size()];
-        } while (wallIndex1 == wallIndex2);
+        size_t first = board.rng() % candidates.size();
+        size_t second = board.rng() % (candidates.size() - 1);
+        if (second >= first) second++;
+        wallIndex1 = candidates[first];
+        wallIndex2 = candidates[second];
     }
-    
-    gameMap.gameGates[0] = Gate(gameMap.regularWalls[wallIndex1]);
-    gameMap.gameGates[1] = Gate(gameMap.regularWalls[wallIndex2]);
+
+    map.setGates(Gate(map.regularWalls[wallIndex1]), Gate(map.regularWalls[wallIndex2]));
 }
 
-void Game::generateItems()
-    {
-        generateGItem();
-        generatePItem();
-        generateTItem();
+void Game::placeItems(StageBoard& board)
+{
+    // 한 종류가 빈 칸의 1/8을 넘지 않도록 제한 (무작위 배치가 끝나지 않는 일 방지)
+    size_t limit = std::max<size_t>(1, (size_t)board.map.mapSize.height * board.map.mapSize.width / 8);
+    size_t count = std::min<size_t>(std::max(1, options.itemsPerType), limit);
+    for (Cell kind : {Cell::GROWTH, Cell::POISON, Cell::TIME}) {
+        board.map.resizeItems(kind, count);
     }
-
-void Game::generateTItem()
-    {
-    int row, col;
-        generateRandCoord(row, col);
-    gameMap.timeItemObject = TimeItem(row, col);
+    // 기존 순서(Growth → Poison → Time)대로 번갈아 배치
+    for (size_t i = 0; i < count; ++i) {
+        placeItem(board, Cell::GROWTH, i);
+        placeItem(board, Cell::POISON, i);
+        placeItem(board, Cell::TIME, i);
     }
+}
 
-void Game::generateGItem()
-    {
-    int row, col;
-        generateRandCoord(row, col);
-    gameMap.growthItemObject = GrowthItem(row, col);
+void Game::placeItem(StageBoard& board, Cell kind, size_t index)
+{
+    Coord pos;
+    bool placed = pickItemCell(board, pos);
+    Coord previous = board.map.itemCoord(kind, index);
+    if (!placed) {
+        // 놓을 칸이 없으면 치워 두고(미배치), 뒤따르는 재생성 타이머가 다시 시도
+        board.map.unplaceItem(kind, index);
+        emitCell(board, EventType::CELL_CHANGED, previous);
+        return;
     }
-
-void Game::generatePItem()
-    {
-    int row, col;
-        generateRandCoord(row, col);
-    gameMap.poisonItemObject = PoisonItem(row, col);
+    board.map.placeItem(kind, index, pos);
+    emitCell(board, EventType::CELL_CHANGED, previous);
+    emitItem(board, EventType::ITEM_SPAWNED, itemKindOf(kind), pos);
 }
 
 MapType Game::getMapTypeForStage(int stage)
@@ -984,8 +1478,9 @@ MapType Game::getMapTypeForStage(int stage)
     }
 }
 
-void Game::showEndingScreen()
+UiTask<bool> Game::endingScreen(UiLoop& loop)
 {
+    pauseRenderer();
     try {
         clear();
         refresh();
@@ -1015,7 +1510,7 @@ void Game::showEndingScreen()
         for(int i=0; i<9; ++i) {
             mvwprintw(ending.get(), 1+i, 1, "%s", snake_art[i]);
             wrefresh(ending.get());
-            usleep(90000);
+            co_await loop.sleepFor(std::chrono::milliseconds(90));
         }
         wattroff(ending.get(), A_BOLD);
         wattron(ending.get(), A_BLINK);
@@ -1025,20 +1520,18 @@ void Game::showEndingScreen()
         mvwprintw(ending.get(), 13, 8, "Press 'R' to restart or 'Q' to quit");
         wattroff(ending.get(), A_BOLD);
         wrefresh(ending.get());
-        nodelay(stdscr, FALSE);
         while (true) {
-            int ch = wgetch(ending.get());
+            int ch = co_await loop.nextKey();
             if (ch == 'q' || ch == 'Q') {
-                cleanupNcurses();
-                exit(0);
+                SNAKE_PROFILE_DUMP("ending_screen");
+                co_return false;
             }
             if (ch == 'r' || ch == 'R') {
                 clear();
                 refresh();
-                break;
+                co_return true;
             }
         }
-        nodelay(stdscr, TRUE);
     } catch (const std::exception& e) {
         cleanupNcurses();
         std::cerr << "Ending screen error: " << e.what() << std::endl;
@@ -0,0 +1,150 @@
+#ifndef GRID_H
+#define GRID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "block.h"
+
+using namespace std;
+
+// 칸 하나에 들어있는 오브젝트 종류
+enum class Cell : uint8_t {
+    EMPTY,
+    BORDER,         // 화면 테두리 (맵 바깥 0행/0열, h+1행/w+1열)
+    WALL,
+    IMMUNE_WALL,
+    GATE,
+    HEAD,
+    BODY,
+    GROWTH,
+    POISON,
+    TIME
+};
+
+// 맵 전체의 칸 단위 점유 상태
+// - 바닥 층: 벽·면역벽·게이트·아이템
+// - 스네이크 층: 머리·몸통 (마디가 모두 빠져나가면 바닥 층 값이 다시 보임)
+// 몸통 마디는 한 칸에 겹칠 수 있고(꼬리 연장 등) 아이템 위에 놓일 수도 있으므로
+// 칸마다 스네이크 마디 수를 세고 바닥 층은 따로 보관
+// 좌표는 ncurses board 윈도우와 같은 0 ~ h+1 / 0 ~ w+1 범위
+class OccupancyGrid
+{
+public:
+    OccupancyGrid(int mapHeight, int mapWidth,
+                  std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    OccupancyGrid(const OccupancyGrid& other) = default;
+    // 다른 메모리 리소스로 복사
+    OccupancyGrid(const OccupancyGrid& other, std::pmr::memory_resource* resource)
+        : gridRows(other.gridRows), gridCols(other.gridCols)
+        , groundLayer(other.groundLayer, resource)
+        , cells(other.cells, resource)
+        , snakeSegments(other.snakeSegments, resource) {}
+
+    int rows() const { return gridRows; }
+    int cols() const { return gridCols; }
+
+    bool inBounds(const Coord& pos) const
+    {
+        return pos.row >= 0 && pos.row < gridRows && pos.col >= 0 && pos.col < gridCols;
+    }
+    size_t indexOf(const Coord& pos) const { return (size_t)pos.row * gridCols + pos.col; }
+
+    // 범위 밖 좌표는 BORDER로 취급
+    Cell at(const Coord& pos) const { return inBounds(pos) ? cells[indexOf(pos)] : Cell::BORDER; }
+    Cell groundAt(const Coord& pos) const { return inBounds(pos) ? groundLayer[indexOf(pos)] : Cell::BORDER; }
+
+    // 바닥 층 변경: 그 위에 스네이크가 없으면 보이는 값도 함께 변경
+    void setGround(const Coord& pos, Cell cell);
+
+    // 스네이크 마디(머리/몸통)가 칸에 들어오고 나감
+    // 마지막 마디가 나갈 때만 바닥 층 값으로 복원
+    void enterSnake(const Coord& pos, Cell cell);
+    void leaveSnake(const Coord& pos);
+    // 스네이크가 있는 칸의 표시만 바꿈 (이전 머리 칸 → 몸통)
+    void relabelSnake(const Coord& pos, Cell cell);
+    int snakeCount(const Coord& pos) const { return inBounds(pos) ? snakeSegments[indexOf(pos)] : 0; }
+
+    // 스네이크 층과 아이템을 모두 비움 (벽·게이트만 남김)
+    void clearDynamic();
+
+    const Cell* data() const { return cells.data(); }
+
+private:
+    int gridRows, gridCols;
+    std::pmr::vector<Cell> groundLayer;
+    std::pmr::vector<Cell> cells;
+    std::pmr::vector<uint8_t> snakeSegments;
+};
+
+OccupancyGrid::OccupancyGrid(int mapHeight, int mapWidth, std::pmr::memory_resource* resource)
+    : gridRows(mapHeight + 2)
+    , gridCols(mapWidth + 2)
+    , groundLayer((size_t)(mapHeight + 2) * (mapWidth + 2), Cell::EMPTY, resource)
+    , cells((size_t)(mapHeight + 2) * (mapWidth + 2), Cell::EMPTY, resource)
+    , snakeSegments((size_t)(mapHeight + 2) * (mapWidth + 2), 0, resource)
+{
+    for (int i = 0; i < gridRows; ++i) {
+        for (int j = 0; j < gridCols; ++j) {
+            if (i == 0 || i == gridRows - 1 || j == 0 || j == gridCols - 1) {
+                groundLayer[(size_t)i * gridCols + j] = Cell::BORDER;
+                cells[(size_t)i * gridCols + j] = Cell::BORDER;
+            }
+        }
+    }
+}
+
+void OccupancyGrid::setGround(const Coord& pos, Cell cell)
+{
+    if (!inBounds(pos)) return;
+    size_t idx = indexOf(pos);
+    if (snakeSegments[idx] == 0) {
+        cells[idx] = cell;
+    }
+    groundLayer[idx] = cell;
+}
+
+void OccupancyGrid::enterSnake(const Coord& pos, Cell cell)
+{
+    if (!inBounds(pos)) return;
+    size_t idx = indexOf(pos);
+    if (snakeSegments[idx] < UINT8_MAX) snakeSegments[idx]++;
+    cells[idx] = cell;
+}
+
+void OccupancyGrid::leaveSnake(const Coord& pos)
+{
+    if (!inBounds(pos)) return;
+    size_t idx = indexOf(pos);
+    if (snakeSegments[idx] > 0) snakeSegments[idx]--;
+    if (snakeSegments[idx] == 0) {
+        cells[idx] = groundLayer[idx];
+    } else if (cells[idx] == Cell::HEAD) {
+        // 머리가 있던 칸에 다른 마디가 남아있으면 몸통으로 표시
+        cells[idx] = Cell::BODY;
+    }
+}
+
+void OccupancyGrid::relabelSnake(const Coord& pos, Cell cell)
+{
+    if (!inBounds(pos)) return;
+    size_t idx = indexOf(pos);
+    if (snakeSegments[idx] > 0) {
+        cells[idx] = cell;
+    }
+}
+
+void OccupancyGrid::clearDynamic()
+{
+    for (size_t idx = 0; idx < groundLayer.size(); ++idx) {
+        Cell ground = groundLayer[idx];
+        if (ground == Cell::GROWTH || ground == Cell::POISON || ground == Cell::TIME) {
+            groundLayer[idx] = Cell::EMPTY;
+        }
+        cells[idx] = groundLayer[idx];
+    }
+    std::fill(snakeSegments.begin(), snakeSegments.end(), 0);
+}
+
+#endif
@@ -0,0 +1,449 @@
+#ifndef HIGHSCORE_H
+#define HIGHSCORE_H
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "map.h"
+
+using namespace std;
+
+// 점수 기록 하나
+struct ScoreEntry
+{
+    uint32_t score = 0;         // 최대 길이
+    uint8_t stage = 0;
+    MapType mapType = MapType::BASIC;
+    int64_t time = 0;           // 기록 시각 (unix 초)
+    uint32_t record = 0;        // 로그 안의 레코드 번호
+};
+
+// 디스크 점수 저장소: 추가 전용 로그 + mmap 정렬 인덱스
+//
+// 로그 (원본, 리틀 엔디언, 레코드 24바이트 고정)
+//   u32 score | u8 stage | u8 mapType | u16 0 | i64 time | u32 record | u32 crc32(앞 20바이트)
+//   write() 한 번으로 붙이고 (옵션에 따라 fdatasync), 열 때 크기가 24의 배수가 아니면 잘린 꼬리를 잘라냄
+//   CRC가 틀린 레코드는 인덱스에 넣지 않음
+// 인덱스 (<로그>.idx, 로그에서 언제든 다시 만들 수 있는 캐시, 호스트 바이트 순서)
+//   "SNKI" | u32 version | u64 covered(반영한 로그 레코드 수) | u64 count | u64 0 | 항목 x count
+//   항목 = { u16 board | u16 0 | u32 score | u32 record }, (board 오름차순, score 내림차순, record 오름차순) 정렬
+//   레코드 하나는 스테이지 보드와 맵 타입 보드에 하나씩, 항목 두 개가 됨
+//   임시 파일에 쓴 뒤 rename으로 바꾸므로 도중에 죽어도 이전 인덱스가 남음 (covered 이후는 열 때 로그에서 다시 읽음)
+//
+// 인덱스에 아직 없는 최근 레코드는 메모리의 정렬된 꼬리 목록에 두고, 일정 수가 쌓이면 병합해 인덱스를 다시 씀
+// 순위·상위 K 질의는 인덱스 이진 탐색 + 꼬리 목록 이진 탐색 (전체를 메모리에 올리지 않음)
+// 한 번에 한 프로세스만 쓴다고 가정
+class HighScoreStore
+{
+public:
+    using BoardId = uint16_t;
+
+    static const uint16_t VERSION = 1;
+    static const size_t RECORD_SIZE = 24;
+    // 꼬리 목록이 이 레코드 수를 넘으면 인덱스를 다시 씀
+    static const size_t COMPACT_RECORDS = 4096;
+
+    // 로그를 열거나 만들고 인덱스를 복구 (실패 시 runtime_error)
+    // durable이면 추가할 때마다 fdatasync
+    explicit HighScoreStore(const std::string& logPath, bool durable = true);
+    ~HighScoreStore();
+
+    HighScoreStore(const HighScoreStore&) = delete;
+    HighScoreStore& operator=(const HighScoreStore&) = delete;
+
+    static BoardId stageBoard(int stage) { return (BoardId)(stage & 0xFF); }
+    static BoardId mapBoard(MapType type) { return (BoardId)(0x100 | static_cast<int>(type)); }
+
+    // 기록을 추가하고 레코드 번호를 돌려줌
+    uint32_t append(uint32_t score, int stage, MapType type);
+    // board에서 score의 순위 (score보다 높은 기록 수 + 1, 동점은 같은 순위)
+    uint64_t rank(BoardId board, uint32_t score) const;
+    // board의 기록 수
+    uint64_t size(BoardId board) const;
+    // board의 상위 k개 (높은 점수 순, 동점은 먼저 기록한 순)
+    std::vector<ScoreEntry> top(BoardId board, size_t k) const;
+    uint64_t recordCount() const { return records; }
+    // 꼬리 목록을 인덱스에 병합해 다시 씀
+    void compact();
+
+private:
+    struct IndexEntry
+    {
+        uint16_t board;
+        uint16_t reserved;
+        uint32_t score;
+        uint32_t record;
+    };
+    static_assert(sizeof(IndexEntry) == 12, "IndexEntry must be packed");
+    static const size_t INDEX_HEADER_SIZE = 32;
+
+    std::string logPath, indexPath;
+    bool durable;
+    int logFd = -1;
+    uint64_t records = 0;       // 로그의 레코드 수 (CRC가 틀린 것 포함)
+
+    // mmap된 인덱스
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    const IndexEntry* indexed = nullptr;
+    uint64_t indexedCount = 0;
+    uint64_t covered = 0;
+
+    std::vector<IndexEntry> tail;   // 인덱스 이후 레코드의 항목 (정렬 유지)
+
+    static bool before(const IndexEntry& a, const IndexEntry& b);
+    static uint32_t crc32(const uint8_t* data, size_t length);
+    static void encode(const ScoreEntry& entry, uint8_t* out);
+    static bool decode(const uint8_t* in, ScoreEntry& entry);
+
+    void recoverLog();
+    bool mapIndex();
+    void unmapIndex();
+    void loadTail();
+    void addToTail(const ScoreEntry& entry);
+    ScoreEntry readRecord(uint32_t record) const;
+    // 정렬된 배열에서 board 항목의 [first, last) 범위
+    static void boardRange(const IndexEntry* sorted, size_t count, BoardId board, const IndexEntry*& first, const IndexEntry*& last);
+};
+
+HighScoreStore::HighScoreStore(const std::string& logPath, bool durable)
+    : logPath(logPath), indexPath(logPath + ".idx"), durable(durable)
+{
+    logFd = ::open(logPath.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (logFd < 0) {
+        throw std::runtime_error("Failed to open " + logPath + ": " + std::strerror(errno));
+    }
+    try {
+        recoverLog();
+        bool indexValid = mapIndex();
+        loadTail();
+        // 인덱스가 없거나 깨졌으면, 또는 꼬리가 길면 바로 다시 씀
+        if ((!indexValid && records > 0) || tail.size() / 2 > COMPACT_RECORDS) {
+            compact();
+        }
+    } catch (...) {
+        unmapIndex();
+        ::close(logFd);
+        throw;
+    }
+}
+
+HighScoreStore::~HighScoreStore()
+{
+    unmapIndex();
+    if (logFd >= 0) ::close(logFd);
+}
+
+bool HighScoreStore::before(const IndexEntry& a, const IndexEntry& b)
+{
+    if (a.board != b.board) return a.board < b.board;
+    if (a.score != b.score) return a.score > b.score;
+    return a.record < b.record;
+}
+
+uint32_t HighScoreStore::crc32(const uint8_t* data, size_t length)
+{
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void HighScoreStore::encode(const ScoreEntry& entry, uint8_t* out)
+{
+    std::memset(out, 0, RECORD_SIZE);
+    for (int b = 0; b < 4; ++b) out[b] = (uint8_t)(entry.score >> (8 * b));
+    out[4] = entry.stage;
+    out[5] = (uint8_t)static_cast<int>(entry.mapType);
+    for (int b = 0; b < 8; ++b) out[8 + b] = (uint8_t)((uint64_t)entry.time >> (8 * b));
+    for (int b = 0; b < 4; ++b) out[16 + b] = (uint8_t)(entry.record >> (8 * b));
+    uint32_t crc = crc32(out, 20);
+    for (int b = 0; b < 4; ++b) out[20 + b] = (uint8_t)(crc >> (8 * b));
+}
+
+bool HighScoreStore::decode(const uint8_t* in, ScoreEntry& entry)
+{
+    auto get32 = [&](size_t at) {
+        return (uint32_t)in[at] | ((uint32_t)in[at + 1] << 8) | ((uint32_t)in[at + 2] << 16) | ((uint32_t)in[at + 3] << 24);
+    };
+    if (get32(20) != crc32(in, 20)) return false;
+    entry.score = get32(0);
+    entry.stage = in[4];
+    entry.mapType = static_cast<MapType>(in[5] & 3);
+    entry.time = (int64_t)((uint64_t)get32(8) | ((uint64_t)get32(12) << 32));
+    entry.record = get32(16);
+    return true;
+}
+
+void HighScoreStore::recoverLog()
+{
+    struct stat info;
+    if (::fstat(logFd, &info) < 0) {
+        throw std::runtime_error("Failed to stat " + logPath + ": " + std::strerror(errno));
+    }
+    uint64_t size = (uint64_t)info.st_size;
+    // 추가 도중 죽어 레코드 일부만 남았으면 잘라냄
+    if (size % RECORD_SIZE != 0) {
+        size -= size % RECORD_SIZE;
+        if (::ftruncate(logFd, (off_t)size) < 0) {
+            throw std::runtime_error("Failed to truncate " + logPath + ": " + std::strerror(errno));
+        }
+    }
+    records = size / RECORD_SIZE;
+}
+
+bool HighScoreStore::mapIndex()
+{
+    unmapIndex();
+    int fd = ::open(indexPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct stat info;
+    bool ok = ::fstat(fd, &info) == 0 && (size_t)info.st_size >= INDEX_HEADER_SIZE;
+    void* base = MAP_FAILED;
+    if (ok) {
+        base = ::mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        ok = base != MAP_FAILED;
+    }
+    ::close(fd);
+    if (!ok) return false;
+
+    const uint8_t* header = static_cast<const uint8_t*>(base);
+    uint32_t version;
+    uint64_t headerCovered, count;
+    std::memcpy(&version, header + 4, 4);
+    std::memcpy(&headerCovered, header + 8, 8);
+    std::memcpy(&count, header + 16, 8);
+    // 항목 수가 파일 크기와 맞고, 로그보다 앞서지 않아야 유효
+    bool valid = std::memcmp(header, "SNKI", 4) == 0 && version == VERSION &&
+                 headerCovered <= records &&
+                 (uint64_t)info.st_size == INDEX_HEADER_SIZE + count * sizeof(IndexEntry);
+    if (!valid) {
+        ::munmap(base, (size_t)info.st_size);
+        return false;
+    }
+    mapping = base;
+    mappingSize = (size_t)info.st_size;
+    indexed = reinterpret_cast<const IndexEntry*>(header + INDEX_HEADER_SIZE);
+    indexedCount = count;
+    covered = headerCovered;
+    return true;
+}
+
+void HighScoreStore::unmapIndex()
+{
+    if (mapping) ::munmap(mapping, mappingSize);
+    mapping = nullptr;
+    mappingSize = 0;
+    indexed = nullptr;
+    indexedCount = 0;
+    covered = 0;
+}
+
+void HighScoreStore::loadTail()
+{
+    tail.clear();
+    uint8_t buffer[RECORD_SIZE * 1024];
+    for (uint64_t at = covered; at < records;) {
+        size_t want = (size_t)std::min<uint64_t>(records - at, 1024);
+        ssize_t n = ::pread(logFd, buffer, want * RECORD_SIZE, (off_t)(at * RECORD_SIZE));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            throw std::runtime_error("Failed to read " + logPath + ": " + std::strerror(errno));
+        }
+        size_t got = (size_t)n / RECORD_SIZE;
+        for (size_t i = 0; i < got; ++i) {
+            ScoreEntry entry;
+            if (decode(buffer + i * RECORD_SIZE, entry)) {
+                entry.record = (uint32_t)(at + i);
+                tail.push_back({stageBoard(entry.stage), 0, entry.score, entry.record});
+                tail.push_back({mapBoard(entry.mapType), 0, entry.score, entry.record});
+            }
+        }
+        at += got;
+    }
+    std::sort(tail.begin(), tail.end(), before);
+}
+
+void HighScoreStore::addToTail(const ScoreEntry& entry)
+{
+    for (IndexEntry item : {IndexEntry{stageBoard(entry.stage), 0, entry.score, entry.record},
+                            IndexEntry{mapBoard(entry.mapType), 0, entry.score, entry.record}}) {
+        tail.insert(std::upper_bound(tail.begin(), tail.end(), item, before), item);
+    }
+}
+
+uint32_t HighScoreStore::append(uint32_t score, int stage, MapType type)
+{
+    ScoreEntry entry;
+    entry.score = score;
+    entry.stage = (uint8_t)stage;
+    entry.mapType = type;
+    entry.time = (int64_t)std::time(nullptr);
+    entry.record = (uint32_t)records;
+
+    uint8_t buffer[RECORD_SIZE];
+    encode(entry, buffer);
+    size_t written = 0;
+    while (written < RECORD_SIZE) {
+        ssize_t n = ::write(logFd, buffer + written, RECORD_SIZE - written);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            int error = errno;
+            // 일부만 쓰였으면 되돌려 로그를 레코드 경계에 맞춤 (실패해도 다음에 열 때 잘라냄)
+            if (written > 0) {
+                int ignored = ::ftruncate(logFd, (off_t)(records * RECORD_SIZE));
+                (void)ignored;
+            }
+            throw std::runtime_error("Failed to append score: " + std::string(std::strerror(error)));
+        }
+        written += (size_t)n;
+    }
+    if (durable && ::fdatasync(logFd) < 0) {
+        throw std::runtime_error("Failed to sync " + logPath + ": " + std::strerror(errno));
+    }
+    records++;
+    addToTail(entry);
+    if (tail.size() / 2 > COMPACT_RECORDS) {
+        compact();
+    }
+    return entry.record;
+}
+
+void HighScoreStore::boardRange(const IndexEntry* sorted, size_t count, BoardId board,
+                                const IndexEntry*& first, const IndexEntry*& last)
+{
+    first = std::lower_bound(sorted, sorted + count, IndexEntry{board, 0, UINT32_MAX, 0}, before);
+    last = std::lower_bound(first, sorted + count, board,
+                            [](const IndexEntry& e, BoardId b) { return e.board <= b; });
+}
+
+uint64_t HighScoreStore::rank(BoardId board, uint32_t score) const
+{
+    // (board, score, 0)보다 앞에 있는 항목 = 같은 보드에서 score보다 높은 기록
+    IndexEntry key{board, 0, score, 0};
+    uint64_t higher = 0;
+    const IndexEntry* first;
+    const IndexEntry* last;
+    boardRange(indexed, (size_t)indexedCount, board, first, last);
+    higher += (uint64_t)(std::lower_bound(first, last, key, before) - first);
+    boardRange(tail.data(), tail.size(), board, first, last);
+    higher += (uint64_t)(std::lower_bound(first, last, key, before) - first);
+    return higher + 1;
+}
+
+uint64_t HighScoreStore::size(BoardId board) const
+{
+    const IndexEntry* first;
+    const IndexEntry* last;
+    boardRange(indexed, (size_t)indexedCount, board, first, last);
+    uint64_t count = (uint64_t)(last - first);
+    boardRange(tail.data(), tail.size(), board, first, last);
+    return count + (uint64_t)(last - first);
+}
+
+std::vector<ScoreEntry> HighScoreStore::top(BoardId board, size_t k) const
+{
+    const IndexEntry *a, *aEnd, *b, *bEnd;
+    boardRange(indexed, (size_t)indexedCount, board, a, aEnd);
+    boardRange(tail.data(), tail.size(), board, b, bEnd);
+    std::vector<ScoreEntry> result;
+    result.reserve(std::min<size_t>(k, (size_t)((aEnd - a) + (bEnd - b))));
+    // 두 정렬 범위를 앞에서부터 k개만 병합
+    while (result.size() < k && (a != aEnd || b != bEnd)) {
+        const IndexEntry*& next = (b == bEnd || (a != aEnd && before(*a, *b))) ? a : b;
+        result.push_back(readRecord(next->record));
+        ++next;
+    }
+    return result;
+}
+
+ScoreEntry HighScoreStore::readRecord(uint32_t record) const
+{
+    uint8_t buffer[RECORD_SIZE];
+    ssize_t n = ::pread(logFd, buffer, RECORD_SIZE, (off_t)record * RECORD_SIZE);
+    ScoreEntry entry;
+    if (n != (ssize_t)RECORD_SIZE || !decode(buffer, entry)) {
+        throw std::runtime_error("Corrupt score record " + std::to_string(record));
+    }
+    entry.record = record;
+    return entry;
+}
+
+void HighScoreStore::compact()
+{
+    std::string tmpPath = indexPath + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + tmpPath + ": " + std::strerror(errno));
+    }
+
+    std::vector<uint8_t> out;
+    out.reserve(64 * 1024);
+    bool ok = true;
+    auto drain = [&](bool force) {
+        if (!ok || (!force && out.size() < 60 * 1024)) return;
+        size_t done = 0;
+        while (ok && done < out.size()) {
+            ssize_t n = ::write(fd, out.data() + done, out.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            ok = n > 0;
+            if (ok) done += (size_t)n;
+        }
+        out.clear();
+    };
+
+    uint64_t count = indexedCount + tail.size();
+    uint8_t header[INDEX_HEADER_SIZE] = {'S', 'N', 'K', 'I'};
+    uint32_t version = VERSION;
+    uint64_t newCovered = records;
+    std::memcpy(header + 4, &version, 4);
+    std::memcpy(header + 8, &newCovered, 8);
+    std::memcpy(header + 16, &count, 8);
+    out.insert(out.end(), header, header + INDEX_HEADER_SIZE);
+
+    // 인덱스와 꼬리 목록은 각각 정렬되어 있으므로 한 번 훑어 병합 (스트리밍)
+    const IndexEntry* a = indexed;
+    const IndexEntry* aEnd = indexed + indexedCount;
+    const IndexEntry* b = tail.data();
+    const IndexEntry* bEnd = tail.data() + tail.size();
+    while (a != aEnd || b != bEnd) {
+        const IndexEntry*& next = (b == bEnd || (a != aEnd && before(*a, *b))) ? a : b;
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(next);
+        out.insert(out.end(), bytes, bytes + sizeof(IndexEntry));
+        ++next;
+        drain(false);
+    }
+    drain(true);
+    ok = ok && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || ::rename(tmpPath.c_str(), indexPath.c_str()) < 0) {
+        int error = errno;
+        ::unlink(tmpPath.c_str());
+        throw std::runtime_error("Failed to write " + indexPath + ": " + std::strerror(error));
+    }
+
+    if (!mapIndex()) {
+        throw std::runtime_error("Failed to map " + indexPath);
+    }
+    tail.clear();
+}
+
+#endif
@@ -0,0 +1,276 @@
+// 점수 저장소 교차 검사 도구
+// 무작위 기록을 추가하면서 다시 열기·로그 꼬리 자르기·인덱스 손실을 섞고,
+// 순위·보드 크기·상위 K를 메모리에 둔 전체 기록의 전수 계산과 대조 (어긋나면 종료 코드 1)
+//
+//   g++ -std=c++17 -O2 src/highscore_check.cpp -o highscore_check
+//   ./highscore_check --appends 20000 --seed 1
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "highscore.h"
+
+struct CheckConfig
+{
+    size_t appends = 20000;     // --appends : 추가할 기록 수
+    unsigned seed = 1;          // --seed
+    std::string dir = "/tmp";   // --dir : 임시 로그를 만들 디렉터리
+};
+
+// 저장소 밖에서 본 기록 하나 (레코드 번호 = 배열 위치)
+struct ModelRecord
+{
+    uint32_t score;
+    int stage;
+    MapType type;
+};
+
+class StoreChecker
+{
+public:
+    StoreChecker(const CheckConfig& config, const std::string& logPath);
+    ~StoreChecker();
+
+    int run();
+
+private:
+    static const int STAGES = 5;
+    static const int MAP_TYPES = 4;
+
+    const CheckConfig& config;
+    std::string logPath, indexPath;
+    std::mt19937 rng;
+    std::unique_ptr<HighScoreStore> store;
+    std::vector<ModelRecord> model;
+    std::string staleIndex;     // 옛 인덱스 사본 (되돌려 놓을 때 사용)
+    size_t queries = 0, reopens = 0, truncations = 0, indexLosses = 0;
+
+    std::vector<HighScoreStore::BoardId> boards() const;
+    bool matchesBoard(const ModelRecord& record, HighScoreStore::BoardId board) const;
+    static void copyFile(const std::string& from, const std::string& to);
+    void reopen();
+    void truncateLog();
+    void loseIndex();
+    // 어긋나면 메시지를 출력하고 false
+    bool checkBoard(HighScoreStore::BoardId board, uint32_t score, size_t k);
+    bool checkAll();
+};
+
+StoreChecker::StoreChecker(const CheckConfig& config, const std::string& logPath)
+    : config(config), logPath(logPath), indexPath(logPath + ".idx"), rng(config.seed)
+    , staleIndex(logPath + ".stale")
+{
+    store = std::make_unique<HighScoreStore>(logPath, false);
+}
+
+StoreChecker::~StoreChecker()
+{
+    store.reset();
+    for (const std::string& path : {logPath, indexPath, indexPath + ".tmp", staleIndex}) ::unlink(path.c_str());
+}
+
+std::vector<HighScoreStore::BoardId> StoreChecker::boards() const
+{
+    std::vector<HighScoreStore::BoardId> result;
+    for (int stage = 1; stage <= STAGES; ++stage) result.push_back(HighScoreStore::stageBoard(stage));
+    for (int type = 0; type < MAP_TYPES; ++type) result.push_back(HighScoreStore::mapBoard(static_cast<MapType>(type)));
+    return result;
+}
+
+bool StoreChecker::matchesBoard(const ModelRecord& record, HighScoreStore::BoardId board) const
+{
+    return board == HighScoreStore::stageBoard(record.stage) || board == HighScoreStore::mapBoard(record.type);
+}
+
+void StoreChecker::copyFile(const std::string& from, const std::string& to)
+{
+    // 원본이 없으면 (인덱스를 지운 직후 등) 아무것도 하지 않음
+    int in = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) return;
+    int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    bool ok = out >= 0;
+    uint8_t buffer[64 * 1024];
+    ssize_t n;
+    while (ok && (n = ::read(in, buffer, sizeof(buffer))) > 0) ok = ::write(out, buffer, (size_t)n) == n;
+    ::close(in);
+    if (out >= 0) ::close(out);
+    if (!ok) throw std::runtime_error("Failed to copy " + from + " to " + to);
+}
+
+void StoreChecker::reopen()
+{
+    store.reset();
+    store = std::make_unique<HighScoreStore>(logPath, false);
+    reopens++;
+}
+
+void StoreChecker::truncateLog()
+{
+    // 최근 기록 몇 개를 버리고, 절반은 레코드 중간에서 잘라 추가 도중 죽은 것처럼 만듦
+    store.reset();
+    size_t keep = model.size() - std::min<size_t>(model.size(), rng() % 64);
+    off_t size = (off_t)(keep * HighScoreStore::RECORD_SIZE);
+    if (keep < model.size() && rng() % 2) size += (off_t)(1 + rng() % (HighScoreStore::RECORD_SIZE - 1));
+    if (::truncate(logPath.c_str(), size) < 0) {
+        throw std::runtime_error("Failed to truncate " + logPath + ": " + std::strerror(errno));
+    }
+    model.resize(keep);
+    truncations++;
+    reopen();
+}
+
+void StoreChecker::loseIndex()
+{
+    // 인덱스를 지우거나, 중간에서 자르거나, 머리를 망가뜨리거나, 예전 사본으로 되돌림
+    store.reset();
+    switch (rng() % 4) {
+        case 0:
+            ::unlink(indexPath.c_str());
+            break;
+        case 1: {
+            struct stat info;
+            if (::stat(indexPath.c_str(), &info) == 0 && info.st_size > 0) {
+                if (::truncate(indexPath.c_str(), (off_t)(rng() % (uint64_t)info.st_size)) < 0) {
+                    throw std::runtime_error("Failed to truncate " + indexPath + ": " + std::strerror(errno));
+                }
+            }
+            break;
+        }
+        case 2: {
+            int fd = ::open(indexPath.c_str(), O_WRONLY);
+            if (fd >= 0) {
+                uint8_t garbage = (uint8_t)rng();
+                ssize_t n = ::pwrite(fd, &garbage, 1, (off_t)(rng() % 24));
+                ::close(fd);
+                (void)n;
+            }
+            break;
+        }
+        default:
+            // 되돌릴 사본이 없으면 지금 것을 남겨 두고 다음에 씀
+            if (::rename(staleIndex.c_str(), indexPath.c_str()) < 0) copyFile(indexPath, staleIndex);
+            break;
+    }
+    indexLosses++;
+    reopen();
+}
+
+bool StoreChecker::checkBoard(HighScoreStore::BoardId board, uint32_t score, size_t k)
+{
+    queries++;
+    uint64_t higher = 0, count = 0;
+    std::vector<uint32_t> records;
+    for (uint32_t i = 0; i < model.size(); ++i) {
+        if (!matchesBoard(model[i], board)) continue;
+        count++;
+        if (model[i].score > score) higher++;
+        records.push_back(i);
+    }
+    // 높은 점수 순, 동점은 먼저 기록한 순
+    size_t expectTop = std::min(k, records.size());
+    std::partial_sort(records.begin(), records.begin() + expectTop, records.end(), [&](uint32_t a, uint32_t b) {
+        return model[a].score != model[b].score ? model[a].score > model[b].score : a < b;
+    });
+
+    uint64_t gotRank = store->rank(board, score);
+    uint64_t gotSize = store->size(board);
+    std::vector<ScoreEntry> gotTop = store->top(board, k);
+    bool ok = gotRank == higher + 1 && gotSize == count && gotTop.size() == expectTop;
+    for (size_t i = 0; ok && i < expectTop; ++i) {
+        const ModelRecord& want = model[records[i]];
+        const ScoreEntry& got = gotTop[i];
+        ok = got.record == records[i] && got.score == want.score && got.stage == want.stage && got.mapType == want.type;
+    }
+    if (!ok) {
+        std::fprintf(stderr, "mismatch on board 0x%03x after %zu records: rank(%u) %llu/%llu, size %llu/%llu, top(%zu) %zu/%zu entries\n",
+                     (unsigned)board, model.size(), score, (unsigned long long)gotRank, (unsigned long long)(higher + 1),
+                     (unsigned long long)gotSize, (unsigned long long)count, k, gotTop.size(), expectTop);
+    }
+    return ok;
+}
+
+bool StoreChecker::checkAll()
+{
+    if (store->recordCount() != model.size()) {
+        std::fprintf(stderr, "record count %llu, expected %zu\n", (unsigned long long)store->recordCount(), model.size());
+        return false;
+    }
+    for (HighScoreStore::BoardId board : boards()) {
+        if (!checkBoard(board, (uint32_t)(rng() % 80), 1 + rng() % 50)) return false;
+    }
+    return true;
+}
+
+int StoreChecker::run()
+{
+    // 점수 범위를 좁게 잡아 동점이 많이 생기게 함
+    std::vector<HighScoreStore::BoardId> all = boards();
+    for (size_t i = 0; i < config.appends; ++i) {
+        ModelRecord record{(uint32_t)(rng() % 64), 1 + (int)(rng() % STAGES), static_cast<MapType>(rng() % MAP_TYPES)};
+        uint32_t number = store->append(record.score, record.stage, record.type);
+        if (number != model.size()) {
+            std::fprintf(stderr, "append returned record %u, expected %zu\n", number, model.size());
+            return 1;
+        }
+        model.push_back(record);
+
+        uint32_t roll = rng() % 1000;
+        bool full = true;
+        if (roll < 3) {
+            reopen();
+        } else if (roll < 5) {
+            truncateLog();
+        } else if (roll < 7) {
+            loseIndex();
+        } else {
+            full = false;
+        }
+        if (full ? !checkAll() : (i % 8 == 0 && !checkBoard(all[rng() % all.size()], (uint32_t)(rng() % 80), 1 + rng() % 50))) {
+            return 1;
+        }
+    }
+    reopen();
+    if (!checkAll()) return 1;
+    std::cout << config.appends << " appends (" << model.size() << " kept), " << reopens << " reopens, "
+              << truncations << " truncations, " << indexLosses << " index losses, " << queries << " board checks: OK" << std::endl;
+    return 0;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--appends N] [--seed N] [--dir DIR]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    CheckConfig config;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--appends") == 0 && hasValue) {
+            config.appends = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            config.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--dir") == 0 && hasValue) {
+            config.dir = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::string logPath = config.dir + "/highscore_check-" + std::to_string(::getpid()) + ".log";
+    try {
+        StoreChecker checker(config, logPath);
+        return checker.run();
+    } catch (const std::exception& e) {
+        std::cerr << "High score check error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,198 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+#include <thread>
+#include <ncurses.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "spsc.h"
+
+using namespace std;
+
+// 키 입력 전용 스레드
+// stdin을 poll로 블로킹 대기하다가 바이트가 오면 방향키 이스케이프 시퀀스를 해석해
+// lock-free 큐에 넣음. 소비자는 readKey(즉시) / waitKey(이벤트 대기)로 꺼냄
+// 동작 중에는 ncurses getch()를 쓰면 안 됨 (stdin을 두 곳에서 읽게 됨)
+class InputThread
+{
+public:
+    InputThread() = default;
+    ~InputThread();
+
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    void start(int fd = STDIN_FILENO);
+    void stop();
+
+    // 큐에 키가 없으면 ERR
+    int readKey();
+    // 키가 올 때까지 대기 (timeoutMs < 0 이면 무한 대기), 시간 초과 시 ERR
+    int waitKey(int timeoutMs = -1);
+    // 키가 들어왔다는 알림만 기다림 (키는 꺼내지 않음, 이벤트 루프용). 알림이 왔으면 true
+    bool waitReady(int timeoutMs);
+
+private:
+    // 단독 ESC와 이스케이프 시퀀스를 구분하는 대기 시간
+    static const int ESCAPE_TIMEOUT_MS = 30;
+
+    enum class DecodeState { NORMAL, ESCAPE, SEQUENCE };
+
+    SpscRing<int, 256> keys;
+    std::thread worker;
+    std::atomic<bool> running{false};
+    int inputFd = -1;
+    int stopFd = -1;    // 종료 신호
+    int readyFd = -1;   // 키가 들어왔음을 소비자에게 알림
+    DecodeState state = DecodeState::NORMAL;
+
+    void run();
+    void decode(unsigned char byte);
+    void emit(int key);
+};
+
+InputThread::~InputThread()
+{
+    stop();
+}
+
+void InputThread::start(int fd)
+{
+    if (running.load()) return;
+    inputFd = fd;
+    stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    readyFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopFd < 0 || readyFd < 0) {
+        throw std::runtime_error("Failed to create input eventfd");
+    }
+    running = true;
+    worker = std::thread(&InputThread::run, this);
+}
+
+void InputThread::stop()
+{
+    if (running.exchange(false)) {
+        uint64_t one = 1;
+        ssize_t ignored = write(stopFd, &one, sizeof(one));
+        (void)ignored;
+        worker.join();
+    }
+    if (stopFd >= 0) { close(stopFd); stopFd = -1; }
+    if (readyFd >= 0) { close(readyFd); readyFd = -1; }
+}
+
+int InputThread::readKey()
+{
+    int key;
+    return keys.pop(key) ? key : ERR;
+}
+
+int InputThread::waitKey(int timeoutMs)
+{
+    int key;
+    while (!keys.pop(key)) {
+        pollfd pfd{readyFd, POLLIN, 0};
+        int r = poll(&pfd, 1, timeoutMs);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return ERR;
+        uint64_t count;
+        ssize_t ignored = read(readyFd, &count, sizeof(count));
+        (void)ignored;
+    }
+    return key;
+}
+
+bool InputThread::waitReady(int timeoutMs)
+{
+    pollfd pfd{readyFd, POLLIN, 0};
+    int r;
+    do {
+        r = poll(&pfd, 1, timeoutMs);
+    } while (r < 0 && errno == EINTR);
+    if (r <= 0) return false;
+    uint64_t count;
+    ssize_t ignored = read(readyFd, &count, sizeof(count));
+    (void)ignored;
+    return true;
+}
+
+void InputThread::emit(int key)
+{
+    // 큐가 가득 차면(소비자가 멈춘 상태) 키를 버림
+    if (keys.push(key)) {
+        uint64_t one = 1;
+        ssize_t ignored = write(readyFd, &one, sizeof(one));
+        (void)ignored;
+    }
+}
+
+void InputThread::decode(unsigned char byte)
+{
+    switch (state) {
+        case DecodeState::NORMAL:
+            if (byte == 27) {
+                state = DecodeState::ESCAPE;
+            } else {
+                emit(byte == '\r' ? '\n' : byte);
+            }
+            break;
+        case DecodeState::ESCAPE:
+            // keypad 모드에서는 ESC O A, 아니면 ESC [ A
+            if (byte == '[' || byte == 'O') {
+                state = DecodeState::SEQUENCE;
+            } else {
+                state = DecodeState::NORMAL;
+                emit(27);
+                decode(byte);
+            }
+            break;
+        case DecodeState::SEQUENCE:
+            // 매개변수(숫자, ';')는 건너뛰고 마지막 문자로 판단
+            if ((byte >= '0' && byte <= '9') || byte == ';') break;
+            state = DecodeState::NORMAL;
+            switch (byte) {
+                case 'A': emit(KEY_UP); break;
+                case 'B': emit(KEY_DOWN); break;
+                case 'C': emit(KEY_RIGHT); break;
+                case 'D': emit(KEY_LEFT); break;
+                default: break;     // 그 밖의 시퀀스는 무시
+            }
+            break;
+    }
+}
+
+void InputThread::run()
+{
+    pollfd fds[2] = {{inputFd, POLLIN, 0}, {stopFd, POLLIN, 0}};
+    unsigned char buffer[64];
+    while (running.load()) {
+        int timeout = state == DecodeState::NORMAL ? -1 : ESCAPE_TIMEOUT_MS;
+        int r = poll(fds, 2, timeout);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (r == 0) {
+            // 시퀀스가 끊긴 채 시간 초과: 단독 ESC로 처리
+            if (state == DecodeState::ESCAPE) emit(27);
+            state = DecodeState::NORMAL;
+            continue;
+        }
+        if (fds[1].revents & POLLIN) break;
+        if (fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) break;
+        if (fds[0].revents & POLLIN) {
+            ssize_t n = read(inputFd, buffer, sizeof(buffer));
+            if (n <= 0) {
+                if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+                break;
+            }
+            for (ssize_t i = 0; i < n; ++i) decode(buffer[i]);
+        }
+    }
+}
+
+#endif
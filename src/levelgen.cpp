@@ -0,0 +1,325 @@
+// 오프라인 레벨 생성·검증 도구
+// 모든 MapType 생성기와 시드 고정 무작위 벽 변형으로 레벨을 병렬 생성하고,
+// 플레이할 수 있는 레벨만 레벨 팩 파일로 저장
+//
+//   g++ -std=c++17 -O2 src/levelgen.cpp -pthread -o levelgen
+//   ./levelgen --count 4096 --threads 8 --seed 1 -o levels.pack
+//   ./levelgen --verify levels.pack
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "arena.h"
+#include "map.h"
+#include "levelpack.h"
+
+// 레벨 하나를 검증한 결과
+enum class LevelVerdict : uint8_t {
+    ACCEPTED,
+    SEALED_ITEM_CELL,   // 아이템이 생길 수 있는 칸 중 시작 위치에서 닿지 않는 칸이 있음
+    NO_GATE_PAIR,       // 게이트 후보가 2개 미만이거나 출구가 플레이 영역과 이어지지 않는 후보가 있음
+    COUNT
+};
+
+const char* describe(LevelVerdict verdict)
+{
+    switch (verdict) {
+        case LevelVerdict::ACCEPTED:         return "accepted";
+        case LevelVerdict::SEALED_ITEM_CELL: return "sealed item cell";
+        case LevelVerdict::NO_GATE_PAIR:     return "no gate pair";
+        default:                             return "";
+    }
+}
+
+struct GeneratorConfig
+{
+    size_t count = 4096;        // --count  : 생성할 레벨 수
+    unsigned threads = 0;       // --threads: 0이면 하드웨어 스레드 수
+    uint32_t seed = 1;          // --seed   : 레벨별 시드의 기준값
+    int height = 21;            // --size HxW
+    int width = 41;
+    std::string output = "levels.pack";
+};
+
+// 레벨 번호 → 독립적인 시드 (splitmix32 한 단계)
+uint32_t levelSeed(uint32_t base, size_t index)
+{
+    uint32_t z = base + 0x9E3779B9u * (uint32_t)(index + 1);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+// 시작 위치에서 4방향으로 이동 가능한 칸을 모두 표시 (몸통 칸은 곧 비므로 통과 가능)
+// 반환값은 닿은 칸 수, reached는 격자 인덱스별 표시
+size_t floodFill(const Map& map, std::pmr::vector<uint8_t>& reached, std::pmr::vector<int>& stack)
+{
+    const OccupancyGrid& grid = map.occupancy;
+    reached.assign((size_t)grid.rows() * grid.cols(), 0);
+    stack.clear();
+
+    auto passable = [&](const Coord& pos) {
+        Cell ground = grid.groundAt(pos);
+        return ground != Cell::WALL && ground != Cell::IMMUNE_WALL && ground != Cell::GATE && ground != Cell::BORDER;
+    };
+
+    size_t count = 0;
+    const Coord& start = map.snakeHeadObject.coord;
+    reached[grid.indexOf(start)] = 1;
+    stack.push_back((int)grid.indexOf(start));
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+        count++;
+        Coord pos{index / grid.cols(), index % grid.cols()};
+        for (int d = 0; d < 4; ++d) {
+            Coord next{pos.row + dr[d], pos.col + dc[d]};
+            if (!grid.inBounds(next) || reached[grid.indexOf(next)] || !passable(next)) continue;
+            reached[grid.indexOf(next)] = 1;
+            stack.push_back((int)grid.indexOf(next));
+        }
+    }
+    return count;
+}
+
+// type·stage로 만든 맵에 레코드의 무작위 벽을 더함
+// 시드의 첫 난수는 randomWallCount를 정하는 데 썼으므로, 무작위 벽이 있는 레벨은 하나 건너뜀
+void addRecordWalls(Map& map, const LevelRecord& record)
+{
+    if (record.randomWallCount == 0) return;
+    std::mt19937 rng(record.seed);
+    rng();
+    map.generateRandomWalls(record.randomWallCount, rng);
+}
+
+// 맵이 플레이할 수 있는지 검사. 통과하면 닿는 칸 수와 게이트 후보 수를 채움
+LevelVerdict checkLevel(const Map& map, Arena& arena, size_t& reachable, size_t& gateCount)
+{
+    std::pmr::vector<uint8_t> reached(&arena);
+    std::pmr::vector<int> stack(&arena);
+    stack.reserve((size_t)map.occupancy.rows() * map.occupancy.cols());
+    reachable = floodFill(map, reached, stack);
+
+    // generateRandCoord가 고를 수 있는 칸(빈 칸, 상하좌우가 모두 벽은 아님)은 모두 닿아야 함
+    const OccupancyGrid& grid = map.occupancy;
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    for (int row = 2; row <= map.mapSize.height; ++row) {
+        for (int col = 2; col <= map.mapSize.width; ++col) {
+            Coord pos{row, col};
+            if (grid.groundAt(pos) != Cell::EMPTY || reached[grid.indexOf(pos)]) continue;
+            int wallCount = 0;
+            for (int d = 0; d < 4; ++d) {
+                Cell adj = grid.groundAt(Coord{row + dr[d], col + dc[d]});
+                if (adj == Cell::WALL || adj == Cell::GATE) wallCount++;
+            }
+            if (wallCount < 4) return LevelVerdict::SEALED_ITEM_CELL;
+        }
+    }
+
+    // generateGate는 후보 중 아무 쌍이나 고르므로, 후보 전부의 출구가 플레이 영역에 닿아야 함
+    std::pmr::vector<int> candidates(&arena);
+    if (!map.gateCandidates(candidates)) return LevelVerdict::NO_GATE_PAIR;
+    for (int wallIndex : candidates) {
+        const Coord& wall = map.regularWalls[wallIndex].coord;
+        bool usable = false;
+        for (int d = 0; d < 4 && !usable; ++d) {
+            Coord adj{wall.row + dr[d], wall.col + dc[d]};
+            usable = grid.inBounds(adj) && reached[grid.indexOf(adj)];
+        }
+        if (!usable) return LevelVerdict::NO_GATE_PAIR;
+    }
+    gateCount = candidates.size();
+    return LevelVerdict::ACCEPTED;
+}
+
+// 맵의 내부 벽 (테두리 벽은 맵 크기로 정해지므로 제외)
+void collectInnerWalls(const Map& map, std::vector<Coord>& out)
+{
+    out.clear();
+    for (const Wall& wall : map.regularWalls) {
+        const Coord& pos = wall.coord;
+        bool border = pos.row == 1 || pos.row == map.mapSize.height || pos.col == 1 || pos.col == map.mapSize.width;
+        if (!border) out.push_back(pos);
+    }
+}
+
+// 레벨 번호에 해당하는 맵을 만들고 검증. 통과하면 record를 채움
+LevelVerdict buildLevel(const GeneratorConfig& config, size_t index, Arena& arena, LevelRecord& record)
+{
+    // 앞의 16개는 MapType x 스테이지 1~4의 기본 레이아웃, 이후는 무작위 벽을 더한 변형
+    record.type = (uint8_t)(index % 4);
+    record.stage = (uint8_t)((index / 4) % 4 + 1);
+    record.seed = levelSeed(config.seed, index);
+    std::mt19937 rng(record.seed);
+    record.randomWallCount = index < 16 ? 0 : (uint16_t)(rng() % 6 + 1);
+
+    Map map(config.height, config.width, 0, static_cast<MapType>(record.type), record.stage, &arena);
+    addRecordWalls(map, record);
+    size_t reachable = 0, gateCount = 0;
+    LevelVerdict verdict = checkLevel(map, arena, reachable, gateCount);
+    if (verdict != LevelVerdict::ACCEPTED) return verdict;
+
+    record.reachableCells = (uint16_t)reachable;
+    record.gateCandidates = (uint16_t)gateCount;
+    collectInnerWalls(map, record.walls);
+    return LevelVerdict::ACCEPTED;
+}
+
+int runGenerate(const GeneratorConfig& config)
+{
+    unsigned threadCount = config.threads ? config.threads : std::max(1u, std::thread::hardware_concurrency());
+    // 결과는 레벨 번호 자리에 기록하므로 스레드 수와 무관하게 같은 팩이 만들어짐
+    std::vector<std::optional<LevelRecord>> results(config.count);
+    std::atomic<size_t> nextIndex{0};
+    std::atomic<size_t> verdicts[static_cast<size_t>(LevelVerdict::COUNT)] = {};
+    std::atomic<bool> failed{false};
+    std::string failure;
+
+    auto worker = [&]() {
+        // 스레드마다 아레나 하나: 레벨 하나를 만들 때마다 reset
+        Arena arena;
+        try {
+            for (size_t index = nextIndex++; index < config.count && !failed; index = nextIndex++) {
+                LevelRecord record;
+                LevelVerdict verdict = buildLevel(config, index, arena, record);
+                verdicts[static_cast<size_t>(verdict)]++;
+                if (verdict == LevelVerdict::ACCEPTED) results[index] = std::move(record);
+                arena.reset();
+            }
+        } catch (const std::exception& e) {
+            if (!failed.exchange(true)) failure = e.what();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back(worker);
+    for (auto& thread : workers) thread.join();
+    if (failed) {
+        std::cerr << "Generation failed: " << failure << std::endl;
+        return 1;
+    }
+
+    LevelPack pack;
+    pack.height = config.height;
+    pack.width = config.width;
+    for (auto& result : results) {
+        if (result) pack.levels.push_back(std::move(*result));
+    }
+    pack.save(config.output);
+
+    std::cerr << "Generated " << config.count << " levels on " << threadCount << " threads" << std::endl;
+    for (size_t v = 0; v < static_cast<size_t>(LevelVerdict::COUNT); ++v) {
+        std::cerr << "  " << describe(static_cast<LevelVerdict>(v)) << ": " << verdicts[v] << std::endl;
+    }
+    std::cerr << "Wrote " << pack.levels.size() << " levels to " << config.output << std::endl;
+    return 0;
+}
+
+// 팩의 레벨마다 생성기 입력으로 맵을 다시 만들어, 저장된 벽·통계가 같고 검사를 다시 통과하는지 확인
+// 하나라도 어긋나면 1을 돌려줌
+int runVerify(const std::string& path)
+{
+    LevelPack pack = LevelPack::load(path);
+    if (pack.height < 10 || pack.width < 10 || pack.height > LevelPack::MAX_SIDE || pack.width > LevelPack::MAX_SIDE) {
+        throw std::runtime_error("Level pack map size out of range");
+    }
+    size_t typeCounts[4] = {};
+    size_t walls = 0, reachable = 0;
+    size_t failures = 0;
+    Arena arena;
+    std::vector<Coord> innerWalls;
+    for (size_t i = 0; i < pack.levels.size(); ++i) {
+        const LevelRecord& level = pack.levels[i];
+        if (level.type < 4) typeCounts[level.type]++;
+        walls += level.walls.size();
+        reachable += level.reachableCells;
+
+        const char* problem = nullptr;
+        if (level.type >= 4 || level.stage < 1) {
+            problem = "bad generator input";
+        } else {
+            Map map(pack.height, pack.width, 0, static_cast<MapType>(level.type), level.stage, &arena);
+            addRecordWalls(map, level);
+            size_t levelReachable = 0, gateCount = 0;
+            LevelVerdict verdict = checkLevel(map, arena, levelReachable, gateCount);
+            collectInnerWalls(map, innerWalls);
+            if (verdict != LevelVerdict::ACCEPTED) {
+                problem = describe(verdict);
+            } else if (innerWalls != level.walls) {
+                problem = "walls differ from generator";
+            } else if (levelReachable != level.reachableCells || gateCount != level.gateCandidates) {
+                problem = "stored counts differ";
+            }
+        }
+        arena.reset();
+        if (problem) {
+            failures++;
+            std::cout << "  level " << i << ": " << problem << std::endl;
+        }
+    }
+    std::cout << path << ": " << pack.levels.size() << " levels, " << pack.height << "x" << pack.width << std::endl;
+    std::cout << "  BASIC " << typeCounts[0] << ", MAZE " << typeCounts[1]
+              << ", ISLANDS " << typeCounts[2] << ", CROSS " << typeCounts[3] << std::endl;
+    if (!pack.levels.empty()) {
+        std::cout << "  avg inner walls " << walls / pack.levels.size()
+                  << ", avg reachable cells " << reachable / pack.levels.size() << std::endl;
+    }
+    std::cout << "  " << (pack.levels.size() - failures) << " verified, " << failures << " failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--count N] [--threads N] [--seed N] [--size HxW] [-o FILE]" << std::endl;
+    std::cerr << "       " << program << " --verify FILE" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    GeneratorConfig config;
+    std::string verifyPath;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--count") == 0 && hasValue) {
+            config.count = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            config.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &config.height, &config.width) != 2) {
+                printUsage(argv[0]);
+                return 2;
+            }
+        } else if (std::strcmp(arg, "-o") == 0 && hasValue) {
+            config.output = argv[++i];
+        } else if (std::strcmp(arg, "--verify") == 0 && hasValue) {
+            verifyPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    // 벽 패턴이 들어갈 최소 크기, 좌표는 1바이트로 저장
+    if (config.height < 10 || config.width < 10 ||
+        config.height > LevelPack::MAX_SIDE || config.width > LevelPack::MAX_SIDE) {
+        std::cerr << "Map size must be between 10x10 and " << LevelPack::MAX_SIDE << "x" << LevelPack::MAX_SIDE << std::endl;
+        return 2;
+    }
+
+    try {
+        return verifyPath.empty() ? runGenerate(config) : runVerify(verifyPath);
+    } catch (const std::exception& e) {
+        std::cerr << "Level generator error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,170 @@
+#ifndef LEVELPACK_H
+#define LEVELPACK_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "block.h"
+
+using namespace std;
+
+// 검증을 통과한 레벨 하나 (테두리 벽은 맵 크기로 정해지므로 내부 벽만 저장)
+struct LevelRecord
+{
+    uint8_t type = 0;               // MapType
+    uint8_t stage = 1;              // CROSS 회전 등 스테이지에 따라 달라지는 생성기 입력
+    uint16_t randomWallCount = 0;   // generateRandomWalls 줄 수 (0이면 기본 레이아웃)
+    uint32_t seed = 0;              // generateRandomWalls 시드
+    uint16_t reachableCells = 0;    // 시작 위치에서 닿는 칸 수
+    uint16_t gateCandidates = 0;    // 게이트 후보 벽 수
+    std::vector<Coord> walls;       // 내부 벽 좌표
+};
+
+// 레벨 팩 파일 형식 (리틀 엔디언)
+//   헤더   : "SNKP" | u16 version | u16 height | u16 width | u16 0 | u32 count
+//   오프셋 : u32 x count (각 레벨 레코드의 파일 내 위치, 임의 접근용)
+//   레코드 : u8 type | u8 stage | u16 randomWallCount | u32 seed
+//            | u16 reachableCells | u16 gateCandidates | u16 wallCount | (u8 row, u8 col) x wallCount
+// 좌표를 1바이트로 저장하므로 맵 크기는 255 이하
+class LevelPack
+{
+public:
+    static const uint16_t VERSION = 1;
+    static const int MAX_SIDE = 255;
+
+    int height = 0, width = 0;
+    std::vector<LevelRecord> levels;
+
+    void save(const std::string& path) const;
+    // 형식이 맞지 않으면 runtime_error
+    static LevelPack load(const std::string& path);
+
+private:
+    static const size_t HEADER_SIZE = 16;
+    static const size_t RECORD_HEADER_SIZE = 14;
+
+    static void put16(std::vector<uint8_t>& out, uint16_t value);
+    static void put32(std::vector<uint8_t>& out, uint32_t value);
+    static uint16_t get16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    static uint32_t get32(const uint8_t* p)
+    {
+        return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+};
+
+void LevelPack::put16(std::vector<uint8_t>& out, uint16_t value)
+{
+    out.push_back((uint8_t)(value & 0xFF));
+    out.push_back((uint8_t)(value >> 8));
+}
+
+void LevelPack::put32(std::vector<uint8_t>& out, uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8) out.push_back((uint8_t)(value >> shift));
+}
+
+void LevelPack::save(const std::string& path) const
+{
+    if (height <= 0 || width <= 0 || height > MAX_SIDE || width > MAX_SIDE) {
+        throw std::runtime_error("Level pack map size out of range");
+    }
+
+    // 파일 전체를 버퍼에 만든 뒤 한 번에 씀
+    std::vector<uint8_t> out;
+    out.insert(out.end(), {'S', 'N', 'K', 'P'});
+    put16(out, VERSION);
+    put16(out, (uint16_t)height);
+    put16(out, (uint16_t)width);
+    put16(out, 0);
+    put32(out, (uint32_t)levels.size());
+
+    size_t tableAt = out.size();
+    out.resize(out.size() + 4 * levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const LevelRecord& level = levels[i];
+        uint32_t offset = (uint32_t)out.size();
+        for (int b = 0; b < 4; ++b) out[tableAt + 4 * i + b] = (uint8_t)(offset >> (8 * b));
+        out.push_back(level.type);
+        out.push_back(level.stage);
+        put16(out, level.randomWallCount);
+        put32(out, level.seed);
+        put16(out, level.reachableCells);
+        put16(out, level.gateCandidates);
+        put16(out, (uint16_t)level.walls.size());
+        for (const Coord& wall : level.walls) {
+            out.push_back((uint8_t)wall.row);
+            out.push_back((uint8_t)wall.col);
+        }
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+    bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        throw std::runtime_error("Failed to write " + path);
+    }
+}
+
+LevelPack LevelPack::load(const std::string& path)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[64 * 1024];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    std::fclose(file);
+
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), "SNKP", 4) != 0) {
+        throw std::runtime_error("Not a level pack: " + path);
+    }
+    if (get16(&data[4]) != VERSION) {
+        throw std::runtime_error("Unsupported level pack version");
+    }
+    LevelPack pack;
+    pack.height = get16(&data[6]);
+    pack.width = get16(&data[8]);
+    uint32_t count = get32(&data[12]);
+    if (data.size() < HEADER_SIZE + (size_t)count * 4) {
+        throw std::runtime_error("Truncated level pack");
+    }
+
+    pack.levels.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t at = get32(&data[HEADER_SIZE + 4 * i]);
+        if (at + RECORD_HEADER_SIZE > data.size()) {
+            throw std::runtime_error("Truncated level pack");
+        }
+        const uint8_t* p = &data[at];
+        LevelRecord& level = pack.levels[i];
+        level.type = p[0];
+        level.stage = p[1];
+        level.randomWallCount = get16(p + 2);
+        level.seed = get32(p + 4);
+        level.reachableCells = get16(p + 8);
+        level.gateCandidates = get16(p + 10);
+        uint16_t wallCount = get16(p + 12);
+        if (at + RECORD_HEADER_SIZE + 2 * (size_t)wallCount > data.size()) {
+            throw std::runtime_error("Truncated level pack");
+        }
+        p += RECORD_HEADER_SIZE;
+        level.walls.reserve(wallCount);
+        for (uint16_t w = 0; w < wallCount; ++w) {
+            level.walls.push_back(Coord{p[2 * w], p[2 * w + 1]});
+        }
+    }
+    return pack;
+}
+
+#endif
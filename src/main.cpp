@@ -1,12 +1,62 @@
 #include <vector>
 #include "game.h"
+#include "bot.h"
+#include "frame.h"
+#include "spectator.h"
+#include "dashboard.h"
+#include "worker.h"
 #include <ncurses.h>
 #include <locale.h>
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 using namespace std;
 
+#ifdef SNAKE_INSTRUMENT
+#include <cstdlib>
+#include <new>
+
+// 계측 빌드: 전역 operator new를 교체해 힙 할당 횟수를 센다
+// (배열/nothrow 버전은 표준 기본 구현이 이 함수들을 호출함)
+void* operator new(std::size_t size)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    std::size_t rounded = (size + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, rounded ? rounded : align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// 모든 operator delete가 거치는 해제 함수
+// (인라인되면 컴파일러가 new/delete 짝과 free를 맞대어 -Wmismatched-new-delete 경고를 냄)
+[[gnu::noinline]] static void releaseInstrumented(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p) noexcept { releaseInstrumented(p); }
+void operator delete(void* p, std::size_t) noexcept { releaseInstrumented(p); }
+void operator delete(void* p, std::align_val_t) noexcept { releaseInstrumented(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { releaseInstrumented(p); }
+#endif
+
 // RAII 패턴을 위한 ncurses 초기화 래퍼
 class NcursesInitializer {
 private:
@@ -136,7 +186,9 @@ void drawMainMenu(int selectedOption) {
     refresh();
 }
 
-void showHowToPlay() {
+UiTask<> showHowToPlay(UiLoop& loop) {
+    // catch 안에서는 co_await할 수 없으므로 오류 문구만 남기고 키 대기는 밖에서
+    std::string error;
     try {
         int term_rows, term_cols;
         getmaxyx(stdscr, term_rows, term_cols);
@@ -149,10 +201,10 @@ void showHowToPlay() {
             mvprintw(term_rows/2, (term_cols-30)/2, "터미널 창을 더 크게 해주세요!");
             mvprintw(term_rows/2+1, (term_cols-38)/2, "(최소 %d x %d 이상 필요)", box_width, box_height);
             refresh();
-            getch();
+            co_await loop.nextKey();
             clear();
             refresh();
-            return;
+            co_return;
         }
 
         // RAII 패턴으로 윈도우 관리
@@ -184,77 +236,596 @@ void showHowToPlay() {
         mvwprintw(howto.get(), 13, 3, "* Complete all missions to advance stage!");
         mvwprintw(howto.get(), box_height-2, (box_width-32)/2, "Press any key to return to main menu");
         wrefresh(howto.get());
-        getch();
-        clear();
-        refresh();
+        co_await loop.nextKey();
     } catch (const std::exception& e) {
+        error = e.what();
+    }
+    if (!error.empty()) {
         clear();
-        mvprintw(0, 0, "Error in How to Play: %s", e.what());
-        refresh();
-        getch();
-        clear();
+        mvprintw(0, 0, "Error in How to Play: %s", error.c_str());
         refresh();
+        co_await loop.nextKey();
     }
+    clear();
+    refresh();
 }
 
-int main() {
-    setlocale(LC_ALL, "");
+// 헤드리스 실행 설정 (--headless)
+struct HeadlessConfig
+{
+    bool diff = false;          // --diff  : 바뀐 칸만 ANSI 커서 이동으로 출력
+    long frames = 1000;         // --frames: 출력할 프레임 수 (0이면 무한)
+    unsigned int seed = 0;      // --seed  : 맵/아이템/자동 조종 시드
+    int fps = 0;                // --fps   : 0이면 속도 제한 없음
+};
 
-    try {
-        NcursesInitializer ncursesInitializer;
-        validateTerminalSize();
+// --dashboard N: 게임 수 상한 (화면에는 들어가는 만큼만 그림)
+const long MAX_DASHBOARD_GAMES = 256;
+
+// 병렬 배치 실행 설정 (--batch, 시드·아이템·맵 크기는 헤드리스와 같은 옵션 사용)
+struct BatchConfig
+{
+    long runs = 0;              // --batch  : 끝낼 판(스테이지 시도) 수
+    unsigned threads = 0;       // --threads: 0이면 하드웨어 스레드 수
+    size_t gamesPerThread = 1;  // --games-per-thread: 워커 하나가 번갈아 진행하는 게임 수
+    bool pin = true;            // --no-pin: 워커를 코어에 고정하지 않음
+};
 
-        int inputCharacter, menuOptionSelected = 1;
-        int lastMenuOption = 0; // 이전 메뉴 옵션을 추적
-        Game gameInstance;
+// 배치 워커가 게임 하나당 처음 확보하는 메모리 (모자라면 더 받음)
+const size_t WORKER_MEMORY_PER_GAME = 256 * 1024;
+
+// 한 판이 이 틱 수를 넘으면 중단하고 새로 시작 (자동 조종이 끝없이 맴도는 경우)
+const uint64_t MAX_RUN_TICKS = 100000;
+
+// 대화형 실행의 기본 점수 저장소 (--scores FILE로 변경)
+const char* const DEFAULT_SCORES_PATH = "snake_scores.log";
+
+// 헤드리스/대화형 공통 (--items N: 종류별 동시 아이템 수)
+int itemsPerType = 1;
+// 헤드리스/대화형 공통 (--map-size HxW: 맵 크기, 터미널보다 크면 보드가 스크롤)
+int mapHeight = 21;
+int mapWidth = 41;
+const int MIN_MAP_SIDE = 10;
+const int MAX_MAP_SIDE = 1000;
+// 대화형 전용 (--sim-hz N: 시뮬레이션 스텝 주기, --speed X: 스네이크 속도 배율)
+int simHz = 1000;
+double speedScale = 1.0;
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--headless [--diff] [--frames N] [--seed N] [--fps N]] [--dashboard N] [--items N] [--map-size HxW] [--sim-hz N] [--speed X] [--spectate SOCKET] [--telemetry FILE] [--scores FILE]" << std::endl;
+    std::cerr << "       " << program << " --batch N [--threads N] [--games-per-thread N] [--no-pin] [--seed N] [--items N] [--map-size HxW]" << std::endl;
+    std::cerr << "       " << program << " --watch SOCKET" << std::endl;
+    std::cerr << "       " << program << " [--scores FILE] --top N" << std::endl;
+}
 
-        // 초기 메뉴 그리기
-        drawMainMenu(menuOptionSelected);
+// ncurses 없이 자동 조종으로 게임을 진행하며 프레임을 stdout으로 스트리밍
+int runHeadless(const HeadlessConfig& config, SpectatorServer* spectator, TelemetryWriter* telemetry, HighScoreStore* scores) {
+    GameOptions options;
+    options.headless = true;
+    options.seed = config.seed;
+    options.itemsPerType = itemsPerType;
+    options.mapHeight = mapHeight;
+    options.mapWidth = mapWidth;
+    Game game(options);
+    game.attachSpectator(spectator);
+    game.attachTelemetry(telemetry);
+    game.attachHighScores(scores);
+    AutoPilot pilot(config.seed ? config.seed : 1);
+    FrameSerializer serializer;
+    bool toTerminal = isatty(STDOUT_FILENO);
+
+    for (long frame = 0; config.frames == 0 || frame < config.frames; ++frame) {
+        TickResult result = game.tick(pilot.nextKey(game.map(), &game.reachability(), &game.missionProgress()));
+        if (result == TickResult::GAME_OVER) {
+            game.restartStage();
+        } else if (result == TickResult::MISSION_COMPLETE) {
+            game.advanceStage();
+        }
+
+        if (config.diff) {
+            serializer.renderDiff(game.map().occupancy);
+        } else {
+            serializer.renderFull(game.map().occupancy, toTerminal);
+        }
+        if (!serializer.writeTo(STDOUT_FILENO)) {
+            return 1;   // 파이프가 닫힘
+        }
+        if (config.fps > 0) {
+            usleep(1000000 / config.fps);
+        }
+    }
+    return 0;
+}
 
-        while(1) {
-            inputCharacter = getch();
+// 헤드리스 게임 count개를 자동 조종으로 돌리며 한 화면에 타일로 그림 (q로 종료)
+// 게임은 그리기와 같은 스레드에서 차례로 진행 (게임 i의 시드 = seed + i)
+int runDashboard(const HeadlessConfig& config, long count) {
+    GameOptions options;
+    options.headless = true;
+    options.itemsPerType = itemsPerType;
+    options.mapHeight = mapHeight;
+    options.mapWidth = mapWidth;
+    unsigned int baseSeed = config.seed ? config.seed : static_cast<unsigned int>(time(nullptr));
+    // Game은 아레나를 소유하므로 힙에 하나씩
+    std::vector<std::unique_ptr<Game>> games;
+    std::vector<AutoPilot> pilots;
+    std::vector<Dashboard::TileStatus> statuses(count);
+    games.reserve(count);
+    pilots.reserve(count);
+    for (long i = 0; i < count; ++i) {
+        options.seed = baseSeed + static_cast<unsigned int>(i);
+        games.push_back(std::make_unique<Game>(options));
+        pilots.emplace_back(options.seed);
+    }
 
-            // 키 입력이 없으면 계속 대기
-            if (inputCharacter == ERR) {
-                usleep(50000); // 50ms 대기
-                continue;
+    NcursesInitializer ncursesInitializer;
+    const OccupancyGrid& first = games[0]->map().occupancy;
+    Dashboard dashboard(first.rows(), first.cols(), games.size());
+    char header[128];
+    for (long frame = 0; config.frames == 0 || frame < config.frames; ++frame) {
+        if (getch() == 'q') break;
+        for (size_t i = 0; i < games.size(); ++i) {
+            Game& game = *games[i];
+            Dashboard::TileStatus& status = statuses[i];
+            TickResult result = game.tick(pilots[i].nextKey(game.map(), &game.reachability(), &game.missionProgress()));
+            if (result == TickResult::GAME_OVER) {
+                status.deaths++;
+                game.restartStage();
+            } else if (result == TickResult::MISSION_COMPLETE) {
+                status.clears++;
+                game.advanceStage();
             }
+            status.stage = game.stage();
+            status.length = static_cast<int>(game.map().snakeHeadObject.snakeBodySegments.size());
+            status.maxLength = game.maxLength();
+        }
 
-            switch(inputCharacter) {
-                case KEY_UP:
-                    menuOptionSelected = (menuOptionSelected > 1) ? menuOptionSelected - 1 : 3;
-                    break;
-                case KEY_DOWN:
-                    menuOptionSelected = (menuOptionSelected < 3) ? menuOptionSelected + 1 : 1;
-                    break;
-                case 10: // Enter key
-                    if(menuOptionSelected == 1) {
-                        gameInstance = Game();
-                        gameInstance.refreshScreen();
-                        // 게임에서 돌아온 후 메뉴 다시 그리기
-                        drawMainMenu(menuOptionSelected);
-                        lastMenuOption = menuOptionSelected;
-                    }
-                    else if(menuOptionSelected == 2) {
-                        nodelay(stdscr, FALSE);
-                        showHowToPlay();
-                        nodelay(stdscr, TRUE);
-                        // How to Play에서 돌아온 후 메뉴 다시 그리기
-                        drawMainMenu(menuOptionSelected);
-                        lastMenuOption = menuOptionSelected;
+        std::snprintf(header, sizeof(header), "Dashboard: %zu games, showing %zu, frame %ld  (q: quit)",
+                      games.size(), dashboard.tileCount(), frame + 1);
+        dashboard.drawHeader(header);
+        for (size_t i = 0; i < dashboard.tileCount(); ++i) {
+            dashboard.drawTile(i, games[i]->map().occupancy, statuses[i]);
+        }
+        dashboard.present();
+        if (config.fps > 0) {
+            usleep(1000000 / config.fps);
+        }
+    }
+    return 0;
+}
+
+// 배치 실행 결과 (판 끝 방식·스테이지·아이템·게이트 히스토그램)
+void printBatchReport(const StatsTotals& totals, unsigned threadCount, double seconds) {
+    std::printf("%llu runs on %u threads in %.2fs (%.0f runs/s, %.2fM ticks/s)\n",
+                (unsigned long long)totals.runs, threadCount, seconds,
+                totals.runs / seconds, totals.ticks / seconds / 1e6);
+    std::printf("\nOutcome\n");
+    std::printf("  %-42s %10llu\n", "Mission complete", (unsigned long long)totals.clears);
+    for (size_t i = 0; i < StatsTotals::DEATH_REASONS; ++i) {
+        if (totals.deaths[i] == 0) continue;
+        const char* reason = describe(static_cast<DeathReason>(i));
+        std::printf("  %-42s %10llu\n", *reason ? reason : "Game over", (unsigned long long)totals.deaths[i]);
+    }
+    if (totals.abandoned > 0) {
+        std::printf("  %-42s %10llu\n", "Abandoned (tick limit)", (unsigned long long)totals.abandoned);
+    }
+    std::printf("\nStage reached\n");
+    for (size_t stage = 1; stage <= StatsTotals::MAX_STAGE; ++stage) {
+        std::printf("  Stage %zu %10llu\n", stage, (unsigned long long)totals.stages[stage]);
+    }
+    std::printf("\nItems consumed: growth %llu, poison %llu, time %llu\n",
+                (unsigned long long)totals.items[static_cast<size_t>(ItemKind::GROWTH)],
+                (unsigned long long)totals.items[static_cast<size_t>(ItemKind::POISON)],
+                (unsigned long long)totals.items[static_cast<size_t>(ItemKind::TIME)]);
+    std::printf("Gates used: %llu\n", (unsigned long long)totals.gates);
+    auto printHistogram = [](const char* title, const uint64_t* buckets) {
+        std::printf("\n%s\n", title);
+        for (size_t b = 0; b < StatsTotals::RUN_BUCKETS; ++b) {
+            if (buckets[b] == 0) continue;
+            uint32_t low = StatsTotals::bucketFloor(b);
+            if (b + 1 == StatsTotals::RUN_BUCKETS) {
+                std::printf("  %5u+      %10llu\n", low, (unsigned long long)buckets[b]);
+            } else {
+                uint32_t high = StatsTotals::bucketFloor(b + 1) - 1;
+                std::printf("  %5u-%-5u %10llu\n", low, high, (unsigned long long)buckets[b]);
+            }
+        }
+    };
+    printHistogram("Items per run", totals.itemsPerRun);
+    printHistogram("Gates per run", totals.gatesPerRun);
+}
+
+// 헤드리스 게임을 워커 스레드마다 gamesPerThread개씩 돌려 runs판을 끝내고 통계를 출력
+// 워커는 코어에 고정되고, 자기 게임들을 자기 메모리에 연속으로 놓음 (worker.h)
+// 통계는 워커별 샤드에 잠금 없이 쌓고, 보고 스레드가 1초마다 합쳐 처리량을 stderr로 출력
+int runBatch(const HeadlessConfig& config, const BatchConfig& batch) {
+    using Clock = std::chrono::steady_clock;
+    unsigned threadCount = batch.threads ? batch.threads : std::max(1u, std::thread::hardware_concurrency());
+    unsigned int baseSeed = config.seed ? config.seed : static_cast<unsigned int>(time(nullptr));
+    StatsAggregator stats(threadCount);
+    std::atomic<long> nextRun{0};
+    std::atomic<bool> failed{false};
+    std::atomic<bool> finished{false};
+    std::string failure;
+
+    auto worker = [&](size_t index) {
+        try {
+            // 코어에 먼저 고정한 뒤 메모리를 확보해야 페이지가 이 코어 쪽 NUMA 노드에 놓임
+            if (batch.pin && !pinCurrentThread(index) && index == 0) {
+                std::cerr << "Warning: could not pin batch workers to cores" << std::endl;
+            }
+            std::pmr::monotonic_buffer_resource memory(WORKER_MEMORY_PER_GAME * batch.gamesPerThread);
+            GameOptions options;
+            options.headless = true;
+            options.seed = baseSeed + static_cast<unsigned int>(index * batch.gamesPerThread);
+            options.itemsPerType = itemsPerType;
+            options.mapHeight = mapHeight;
+            options.mapWidth = mapWidth;
+            GameBlock games(batch.gamesPerThread, options, &memory);
+            StatsShard& shard = stats.shard(index);
+            std::pmr::vector<AutoPilot> pilots(&memory);
+            // 판별 값은 게임마다 따로 셈 (게임들이 샤드 하나를 같이 쓰므로). 주소를 Game에 넘기므로 미리 확보
+            std::pmr::vector<StatsRun> runStats(&memory);
+            std::pmr::vector<uint64_t> runTicks(games.size(), 0, &memory);
+            pilots.reserve(games.size());
+            runStats.reserve(games.size());
+            for (size_t g = 0; g < games.size(); ++g) {
+                runStats.emplace_back(shard);
+                games[g].attachStats(&runStats[g]);
+                pilots.emplace_back(options.seed + static_cast<unsigned int>(g));
+            }
+            // 판 번호를 하나씩 가져가므로 빨리 끝나는 게임·워커가 더 많은 판을 맡음
+            // 게임마다 판 하나를 맡고, 판이 끝나면 다음 번호를 가져감 (남은 판이 없으면 그 게임은 쉼)
+            size_t active = 0;
+            std::pmr::vector<char> playing(games.size(), 0, &memory);
+            for (size_t g = 0; g < games.size(); ++g) {
+                if (nextRun++ < batch.runs) {
+                    playing[g] = 1;
+                    active++;
+                }
+            }
+            while (active > 0 && !failed) {
+                for (size_t g = 0; g < games.size(); ++g) {
+                    if (!playing[g]) continue;
+                    Game& game = games[g];
+                    TickResult result = game.tick(pilots[g].nextKey(game.map(), &game.reachability(), &game.missionProgress()));
+                    shard.addTicks(1);
+                    bool ended = true;
+                    if (result == TickResult::GAME_OVER) {
+                        runStats[g].endRun(game.stage(), RunEnd::DIED);
+                        game.restartStage();
+                    } else if (result == TickResult::MISSION_COMPLETE) {
+                        runStats[g].endRun(game.stage(), RunEnd::CLEARED);
+                        game.advanceStage();
+                    } else if (++runTicks[g] >= MAX_RUN_TICKS) {
+                        runStats[g].endRun(game.stage(), RunEnd::ABANDONED);
+                        game.restartStage();
+                    } else {
+                        ended = false;
                     }
-                    else if(menuOptionSelected == 3) {
-                        return 0;
+                    if (ended) {
+                        runTicks[g] = 0;
+                        if (nextRun++ >= batch.runs) {
+                            playing[g] = 0;
+                            active--;
+                        }
                     }
-                    continue; // Enter 키 처리 후 메뉴 다시 그리기 건너뛰기
+                }
+            }
+        } catch (const std::exception& e) {
+            if (!failed.exchange(true)) failure = e.what();
+        }
+    };
+
+    Clock::time_point start = Clock::now();
+    std::thread reporter([&]() {
+        uint64_t lastRuns = 0, lastTicks = 0;
+        Clock::time_point lastTime = start;
+        while (!finished) {
+            // 종료를 오래 기다리지 않도록 잘게 나눠 잠
+            for (int slice = 0; slice < 20 && !finished; ++slice) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
             }
+            if (finished) break;
+            StatsTotals totals = stats.collect();
+            Clock::time_point now = Clock::now();
+            double interval = std::chrono::duration<double>(now - lastTime).count();
+            std::fprintf(stderr, "[%6.1fs] runs %llu/%ld (%.0f/s)  ticks %llu (%.2fM/s)\n",
+                         std::chrono::duration<double>(now - start).count(),
+                         (unsigned long long)totals.runs, batch.runs, (totals.runs - lastRuns) / interval,
+                         (unsigned long long)totals.ticks, (totals.ticks - lastTicks) / interval / 1e6);
+            lastRuns = totals.runs;
+            lastTicks = totals.ticks;
+            lastTime = now;
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back(worker, i);
+    for (auto& thread : workers) thread.join();
+    finished = true;
+    reporter.join();
+    if (failed) {
+        std::cerr << "Batch failed: " << failure << std::endl;
+        return 1;
+    }
+    printBatchReport(stats.collect(), threadCount, std::chrono::duration<double>(Clock::now() - start).count());
+    return 0;
+}
+
+// 스테이지별·맵 타입별 상위 count개 출력
+int printLeaderboards(const HighScoreStore& scores, size_t count) {
+    static const char* mapNames[] = {"BASIC", "MAZE", "ISLANDS", "CROSS"};
+    std::cout << scores.recordCount() << " records" << std::endl;
+    auto printBoard = [&](const char* title, HighScoreStore::BoardId board) {
+        uint64_t size = scores.size(board);
+        if (size == 0) return;
+        std::cout << std::endl << title << " (" << size << " records)" << std::endl;
+        int place = 1;
+        for (const ScoreEntry& entry : scores.top(board, count)) {
+            char when[32] = "";
+            time_t t = static_cast<time_t>(entry.time);
+            std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M", std::localtime(&t));
+            std::cout << "  " << place++ << ". " << entry.score << "  stage " << (int)entry.stage
+                      << "  " << mapNames[static_cast<int>(entry.mapType)] << "  " << when << std::endl;
+        }
+    };
+    for (int stage = 1; stage <= 4; ++stage) {
+        printBoard(("Stage " + std::to_string(stage)).c_str(), HighScoreStore::stageBoard(stage));
+    }
+    for (int type = 0; type < 4; ++type) {
+        printBoard(mapNames[type], HighScoreStore::mapBoard(static_cast<MapType>(type)));
+    }
+    return 0;
+}
 
-            // 메뉴 옵션이 변경된 경우에만 다시 그리기
-            if (menuOptionSelected != lastMenuOption) {
-                drawMainMenu(menuOptionSelected);
-                lastMenuOption = menuOptionSelected;
+// 관전 서버에 접속해 받은 델타를 ANSI diff 프레임으로 출력
+int runWatch(const std::string& socketPath) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "Failed to connect to " << socketPath << ": " << std::strerror(errno) << std::endl;
+        if (fd >= 0) close(fd);
+        return 1;
+    }
+
+    SpectatorDecoder decoder;
+    FrameSerializer serializer;
+    uint8_t buffer[64 * 1024];
+    while (true) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        try {
+            if (!decoder.feed(buffer, static_cast<size_t>(n)) || !decoder.grid()) continue;
+        } catch (const std::runtime_error& e) {
+            // 깨진 스트림은 더 해석하지 않고 끊음
+            std::cerr << e.what() << std::endl;
+            close(fd);
+            return 1;
+        }
+        serializer.renderDiff(*decoder.grid());
+        if (!serializer.writeTo(STDOUT_FILENO)) break;
+    }
+    close(fd);
+    return 0;
+}
+
+// 메인 메뉴 (Exit를 고르면 끝남). 게임·설명 화면은 이 코루틴 안에서 co_await로 이어짐
+UiTask<> mainMenu(UiLoop& loop, InputThread& input, SpectatorServer* spectator, TelemetryWriter* telemetry, HighScoreStore* scores) {
+    int menuOptionSelected = 1;
+    drawMainMenu(menuOptionSelected);
+
+    while (true) {
+        // 키가 들어올 때까지 이벤트 루프에 양보
+        switch (co_await loop.nextKey()) {
+            case KEY_UP:
+                menuOptionSelected = (menuOptionSelected > 1) ? menuOptionSelected - 1 : 3;
+                break;
+            case KEY_DOWN:
+                menuOptionSelected = (menuOptionSelected < 3) ? menuOptionSelected + 1 : 1;
+                break;
+            case 10: // Enter key
+                if (menuOptionSelected == 1) {
+                    // Game은 아레나를 소유하므로 복사 대신 매 판 새로 생성
+                    GameOptions gameOptions;
+                    gameOptions.input = &input;
+                    gameOptions.itemsPerType = itemsPerType;
+                    gameOptions.mapHeight = mapHeight;
+                    gameOptions.mapWidth = mapWidth;
+                    gameOptions.simHz = simHz;
+                    gameOptions.speedScale = speedScale;
+                    Game gameInstance(gameOptions);
+                    gameInstance.attachSpectator(spectator);
+                    gameInstance.attachTelemetry(telemetry);
+                    gameInstance.attachHighScores(scores);
+                    co_await gameInstance.play(loop);
+                } else if (menuOptionSelected == 2) {
+                    co_await showHowToPlay(loop);
+                } else if (menuOptionSelected == 3) {
+                    co_return;
+                }
+                break;
+            default:
+                continue;   // 메뉴와 상관없는 키는 다시 그리지 않음
+        }
+        drawMainMenu(menuOptionSelected);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    setlocale(LC_ALL, "");
+
+    bool headless = false;
+    HeadlessConfig headlessConfig;
+    std::string spectateSocket;
+    std::string watchSocket;
+    std::string telemetryPath;
+    std::string scoresPath;
+    long topCount = 0;
+    long dashboardCount = 0;
+    BatchConfig batchConfig;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(arg, "--diff") == 0) {
+            headlessConfig.diff = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            headlessConfig.frames = std::atol(argv[++i]);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            headlessConfig.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--fps") == 0 && hasValue) {
+            headlessConfig.fps = std::atoi(argv[++i]);
+        } else if (std::strcmp(arg, "--dashboard") == 0 && hasValue) {
+            dashboardCount = std::atol(argv[++i]);
+            if (dashboardCount < 1 || dashboardCount > MAX_DASHBOARD_GAMES) {
+                std::cerr << "--dashboard must be between 1 and " << MAX_DASHBOARD_GAMES << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--batch") == 0 && hasValue) {
+            batchConfig.runs = std::atol(argv[++i]);
+            if (batchConfig.runs <= 0) {
+                printUsage(argv[0]);
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            batchConfig.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--games-per-thread") == 0 && hasValue) {
+            long games = std::atol(argv[++i]);
+            if (games < 1 || games > MAX_DASHBOARD_GAMES) {
+                std::cerr << "--games-per-thread must be between 1 and " << MAX_DASHBOARD_GAMES << std::endl;
+                return 2;
+            }
+            batchConfig.gamesPerThread = static_cast<size_t>(games);
+        } else if (std::strcmp(arg, "--no-pin") == 0) {
+            batchConfig.pin = false;
+        } else if (std::strcmp(arg, "--items") == 0 && hasValue) {
+            itemsPerType = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--map-size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &mapHeight, &mapWidth) != 2) {
+                printUsage(argv[0]);
+                return 2;
+            }
+            if (mapHeight < MIN_MAP_SIDE || mapWidth < MIN_MAP_SIDE || mapHeight > MAX_MAP_SIDE || mapWidth > MAX_MAP_SIDE) {
+                std::cerr << "Map size must be between " << MIN_MAP_SIDE << "x" << MIN_MAP_SIDE << " and "
+                          << MAX_MAP_SIDE << "x" << MAX_MAP_SIDE << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--sim-hz") == 0 && hasValue) {
+            simHz = std::atoi(argv[++i]);
+            if (simHz < AccumulatorScheduler::MIN_SIM_HZ || simHz > AccumulatorScheduler::MAX_SIM_HZ) {
+                std::cerr << "--sim-hz must be between " << AccumulatorScheduler::MIN_SIM_HZ
+                          << " and " << AccumulatorScheduler::MAX_SIM_HZ << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--speed") == 0 && hasValue) {
+            speedScale = std::atof(argv[++i]);
+            if (!(speedScale > 0)) {
+                printUsage(argv[0]);
+                return 2;
             }
+        } else if (std::strcmp(arg, "--spectate") == 0 && hasValue) {
+            spectateSocket = argv[++i];
+        } else if (std::strcmp(arg, "--telemetry") == 0 && hasValue) {
+            telemetryPath = argv[++i];
+        } else if (std::strcmp(arg, "--scores") == 0 && hasValue) {
+            scoresPath = argv[++i];
+        } else if (std::strcmp(arg, "--top") == 0 && hasValue) {
+            topCount = std::atol(argv[++i]);
+            if (topCount <= 0) {
+                printUsage(argv[0]);
+                return 2;
+            }
+        } else if (std::strcmp(arg, "--watch") == 0 && hasValue) {
+            watchSocket = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (!watchSocket.empty()) {
+        return runWatch(watchSocket);
+    }
+    if (batchConfig.runs > 0) {
+        try {
+            return runBatch(headlessConfig, batchConfig);
+        } catch (const std::exception& e) {
+            std::cerr << "Batch error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (dashboardCount > 0) {
+        try {
+            return runDashboard(headlessConfig, dashboardCount);
+        } catch (const std::exception& e) {
+            std::cerr << "Dashboard error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // 관전 서버 (링 버퍼가 크므로 힙에 생성)
+    std::unique_ptr<SpectatorServer> spectator;
+    if (!spectateSocket.empty()) {
+        try {
+            spectator = std::make_unique<SpectatorServer>();
+            spectator->start(spectateSocket);
+        } catch (const std::exception& e) {
+            std::cerr << "Spectator error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // 텔레메트리 기록기 (열 버퍼가 크므로 힙에 생성, 파일은 이어 쓰기)
+    std::unique_ptr<TelemetryWriter> telemetry;
+    if (!telemetryPath.empty()) {
+        try {
+            telemetry = std::make_unique<TelemetryWriter>(telemetryPath);
+        } catch (const std::exception& e) {
+            std::cerr << "Telemetry error: " << e.what() << std::endl;
+            return 1;
         }
+    }
+
+    // 점수 저장소: 대화형은 기본 경로에 항상 기록, 헤드리스는 --scores를 줬을 때만 (fsync 없이)
+    std::unique_ptr<HighScoreStore> scores;
+    if (scoresPath.empty() && !headless) scoresPath = DEFAULT_SCORES_PATH;
+    if (!scoresPath.empty()) {
+        try {
+            scores = std::make_unique<HighScoreStore>(scoresPath, !headless);
+        } catch (const std::exception& e) {
+            std::cerr << "Score store error: " << e.what() << std::endl;
+            if (headless || topCount > 0) return 1;
+            // 대화형은 점수 저장 없이 계속
+        }
+    }
+    if (topCount > 0) {
+        return scores ? printLeaderboards(*scores, static_cast<size_t>(topCount)) : 1;
+    }
+
+    if (headless) {
+        try {
+            return runHeadless(headlessConfig, spectator.get(), telemetry.get(), scores.get());
+        } catch (const std::exception& e) {
+            std::cerr << "Headless error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        NcursesInitializer ncursesInitializer;
+        validateTerminalSize();
+
+        // 이후 모든 키 입력은 입력 스레드를 거침 (getch 사용 금지)
+        InputThread input;
+        input.start();
+
+        UiLoop loop(input);
+        loop.run(mainMenu(loop, input, spectator.get(), telemetry.get(), scores.get()));
     } catch (const std::runtime_error& e) {
         std::cerr << "Runtime error: " << e.what() << std::endl;
         return 1;
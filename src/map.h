@@ -4,7 +4,11 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <memory_resource>
+#include <random>
 #include "block.h" // Assuming block.h is already modified
+#include "grid.h"
+#include "frame.h"
 
 using namespace std;
 
@@ -27,16 +31,22 @@ class Map
 public:
     MapDimensions mapSize;
     SnakeHead snakeHeadObject;
-    vector<ImmunedWall> immuneWalls;
-    vector<Wall> regularWalls;
-    vector<Gate> gameGates;
-    GrowthItem growthItemObject;
-    PoisonItem poisonItemObject;
-    TimeItem timeItemObject;
+    std::pmr::vector<ImmunedWall> immuneWalls;
+    std::pmr::vector<Wall> regularWalls;
+    std::pmr::vector<Gate> gameGates;
+    // 종류별 아이템 (개수는 Game이 정함, 아직 배치 전이면 좌표가 (0, 0))
+    std::pmr::vector<GrowthItem> growthItems;
+    std::pmr::vector<PoisonItem> poisonItems;
+    std::pmr::vector<TimeItem> timeItems;
     MapType currentMapType;
+    OccupancyGrid occupancy;   // 칸 단위 점유 상태 (렌더링·충돌 검사용)
 
-    Map(int mapHeight = 21, int mapWidth = 21, int initialWallCount = 0, MapType type = MapType::BASIC, int stage = 1);
+    // resource: 벽·게이트·몸통 벡터가 사용할 메모리 (스테이지 아레나를 넘기면 reset 한 번에 일괄 해제)
+    Map(int mapHeight = 21, int mapWidth = 21, int initialWallCount = 0, MapType type = MapType::BASIC, int stage = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
     Map(const Map &m) = default;
+    // 모든 벡터를 resource에 새로 할당해 복사 (캐시해 둔 레이아웃을 스테이지 아레나로 복원할 때 사용)
+    Map(const Map &m, std::pmr::memory_resource* resource);
     Map& operator=(const Map &m) = default;
     ~Map() = default;
 
@@ -44,9 +54,35 @@ public:
     bool isPositionValid(const Coord& pos) const;
     bool isPositionOccupied(const Coord& pos) const;
 
+    // 아이템 종류(Cell::GROWTH/POISON/TIME)별 개수 설정 (모두 미배치 상태로 초기화)
+    void resizeItems(Cell kind, size_t count);
+    size_t itemCount(Cell kind) const;
+    const Coord& itemCoord(Cell kind, size_t index) const;
+    // index번 아이템을 to로 옮기고 점유 격자·칸 색인 갱신
+    // (이전 칸은 그 아이템이 그대로 남아있을 때만 비움)
+    void placeItem(Cell kind, size_t index, const Coord& to);
+    // index번 아이템을 맵에서 치워 미배치 상태로 (놓을 칸이 없을 때)
+    void unplaceItem(Cell kind, size_t index);
+    // 칸에 있는 아이템의 종류별 인덱스 (없으면 -1), 종류는 occupancy.groundAt(pos)
+    int itemAt(const Coord& pos) const;
+    // 게이트로 쓸 수 있는 벽의 regularWalls 인덱스
+    // 안쪽 후보(진출 방향 2개 이상)가 2개 미만이면 테두리 후보로 대신 채움. 그래도 2개 미만이면 false
+    bool gateCandidates(std::pmr::vector<int>& out) const;
+    // 시드 고정 무작위 벽 count줄 추가 (전역 rand()를 쓰지 않으므로 여러 스레드에서 동시에 생성 가능)
+    void generateRandomWalls(int count, std::mt19937& rng);
+    // 게이트 쌍 교체 (이전 게이트 칸은 일반 벽으로 복원)
+    void setGates(const Gate& first, const Gate& second);
+    // 오브젝트 목록 기준으로 스네이크·아이템 칸을 다시 구성 (디버그 키 등 직접 편집 뒤 동기화용)
+    void rebuildOccupancy();
+
 private:
+    // 칸별 아이템 색인: 종류별 벡터 인덱스 + 1 (0이면 아이템 없음), 크기는 점유 격자와 같음
+    std::pmr::vector<uint32_t> itemIndex;
+
+    Coord& itemCoordRef(Cell kind, size_t index);
     void initializeWalls();
-    void generateRandomWalls(int count);
+    bool isGateWallValid(const Wall& wall) const;
+    bool isBorderGateWall(const Wall& wall) const;
     void generateMazeMap();
     void generateIslandsMap();
     void generateCrossMap(int rotation);
@@ -56,13 +92,29 @@ private:
 
 // void : 0, wall : 1, immune wall : -1, gate: 2, snake head: 3, snake body: 4
 
-Map::Map(int mapHeight, int mapWidth, int /*initialWallCount*/, MapType type, int stage)
+Map::Map(int mapHeight, int mapWidth, int /*initialWallCount*/, MapType type, int stage,
+         std::pmr::memory_resource* resource)
     : mapSize(mapHeight, mapWidth)
-    , gameGates(2)
+    , snakeHeadObject(resource)
+    , immuneWalls(resource)
+    , regularWalls(resource)
+    , gameGates(2, resource)
+    , growthItems(resource)
+    , poisonItems(resource)
+    , timeItems(resource)
     , currentMapType(type)
+    , occupancy(mapHeight, mapWidth, resource)
+    , itemIndex((size_t)(mapHeight + 2) * (mapWidth + 2), 0, resource)
 {
+    // 생성 중 벡터 재할당이 일어나지 않도록 최대 크기를 미리 확보
+    // 벽: 테두리 2(h+w) + 내부 패턴 (어떤 맵 타입도 테두리 길이의 두 배를 넘지 않음)
+    // 몸통: 최악의 경우 맵 전체
+    immuneWalls.reserve(4);
+    regularWalls.reserve(4 * (mapHeight + mapWidth));
+    snakeHeadObject.snakeBodySegments.reserve(mapHeight * mapWidth);
+
     initializeWalls();
-    snakeHeadObject = SnakeHead(mapHeight / 2, mapWidth / 2);
+    snakeHeadObject.coord = {mapHeight / 2, mapWidth / 2};
     for(int i = 1; i <= 3; ++i) {
         snakeHeadObject.snakeBodySegments.emplace_back(mapHeight / 2 + i, mapWidth / 2);
     }
@@ -76,24 +128,30 @@ Map::Map(int mapHeight, int mapWidth, int /*initialWallCount*/, MapType type, in
         int rotation = (stage - 1) % 4;
         generateCrossMap(rotation);
     }
-    std::vector<Coord> snakeCoords;
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int dc = -1; dc <= 1; ++dc) {
-            snakeCoords.push_back({snakeHeadObject.coord.row + dr, snakeHeadObject.coord.col + dc});
-        }
-    }
-    for (const auto& body : snakeHeadObject.snakeBodySegments) {
-        for (int dr = -1; dr <= 1; ++dr) {
-            for (int dc = -1; dc <= 1; ++dc) {
-                snakeCoords.push_back({body.coord.row + dr, body.coord.col + dc});
-            }
-        }
-    }
+    // 스네이크 주변 8방향 1칸 이내의 벽 제거 (임시 좌표 목록 없이 직접 검사)
     regularWalls.erase(std::remove_if(regularWalls.begin(), regularWalls.end(),
-        [&](const Wall& w) {
-            for(const auto& sc : snakeCoords) if (w.coord == sc) return true;
-            return false;
-        }), regularWalls.end());
+        [&](const Wall& w) { return isNearSnake(w.coord, snakeHeadObject); }), regularWalls.end());
+
+    for (const auto& wall : immuneWalls) occupancy.setGround(wall.coord, Cell::IMMUNE_WALL);
+    for (const auto& wall : regularWalls) occupancy.setGround(wall.coord, Cell::WALL);
+    rebuildOccupancy();
+}
+
+Map::Map(const Map &m, std::pmr::memory_resource* resource)
+    : mapSize(m.mapSize)
+    , snakeHeadObject(m.snakeHeadObject, resource)
+    , immuneWalls(m.immuneWalls, resource)
+    , regularWalls(m.regularWalls, resource)
+    , gameGates(m.gameGates, resource)
+    , growthItems(m.growthItems, resource)
+    , poisonItems(m.poisonItems, resource)
+    , timeItems(m.timeItems, resource)
+    , currentMapType(m.currentMapType)
+    , occupancy(m.occupancy, resource)
+    , itemIndex(m.itemIndex, resource)
+{
+    // 복사는 크기만큼만 확보하므로 몸통 최대 크기를 다시 예약
+    snakeHeadObject.snakeBodySegments.reserve(mapSize.height * mapSize.width);
 }
 
 void Map::initializeWalls()
@@ -240,18 +298,20 @@ bool Map::isNearSnake(const Coord& pos, const SnakeHead& snakeHead) {
     return false;
 }
 
-void Map::generateRandomWalls(int count)
+void Map::generateRandomWalls(int count, std::mt19937& rng)
 {
     while (count--) {
-        int row = rand() % (mapSize.height - 2) + 2;
-        int col = rand() % (mapSize.width - 2) + 2;
-        int length = rand() % 6 + 4;
-        int direction = rand() % 4 + 1;
+        int row = static_cast<int>(rng() % (mapSize.height - 2)) + 2;
+        int col = static_cast<int>(rng() % (mapSize.width - 2)) + 2;
+        int length = static_cast<int>(rng() % 6) + 4;
+        int direction = static_cast<int>(rng() % 4) + 1;
 
         for (int i = 0; i < length; ++i) {
             Coord pos{row, col};
-            if (isPositionValid(pos) && !isPositionOccupied(pos) && !isNearSnake(pos, snakeHeadObject)) {
+            // 점유 격자로 검사하므로 이번에 세운 벽과도 겹치지 않음
+            if (isPositionValid(pos) && occupancy.at(pos) == Cell::EMPTY && !isNearSnake(pos, snakeHeadObject)) {
                 regularWalls.emplace_back(row, col);
+                occupancy.setGround(pos, Cell::WALL);
             }
 
             switch (direction) {
@@ -264,6 +324,55 @@ void Map::generateRandomWalls(int count)
     }
 }
 
+bool Map::isGateWallValid(const Wall& wall) const
+{
+    // 1. 맵 경계에서 너무 가까운 곳은 제외 (모서리 근처)
+    if (wall.coord.row <= 2 || wall.coord.row >= mapSize.height - 1 ||
+        wall.coord.col <= 2 || wall.coord.col >= mapSize.width - 1) {
+        return false;
+    }
+
+    // 2. 상하좌우 중 최소 2방향이 빈 공간이어야 함 (진출로 확보)
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    int openDirections = 0;
+    for (int d = 0; d < 4; ++d) {
+        Coord adj{wall.coord.row + dr[d], wall.coord.col + dc[d]};
+        Cell ground = occupancy.groundAt(adj);
+        bool isWall = ground == Cell::WALL || ground == Cell::GATE || ground == Cell::IMMUNE_WALL;
+        if (!isWall && adj.row > 1 && adj.row < mapSize.height &&
+            adj.col > 1 && adj.col < mapSize.width) {
+            openDirections++;
+        }
+    }
+    return openDirections >= 2;
+}
+
+bool Map::isBorderGateWall(const Wall& wall) const
+{
+    // 테두리 벽 중에서 모서리가 아닌 곳
+    return (wall.coord.row == 1 && wall.coord.col > 3 && wall.coord.col < mapSize.width - 2) ||
+           (wall.coord.row == mapSize.height && wall.coord.col > 3 && wall.coord.col < mapSize.width - 2) ||
+           (wall.coord.col == 1 && wall.coord.row > 3 && wall.coord.row < mapSize.height - 2) ||
+           (wall.coord.col == mapSize.width && wall.coord.row > 3 && wall.coord.row < mapSize.height - 2);
+}
+
+bool Map::gateCandidates(std::pmr::vector<int>& out) const
+{
+    out.clear();
+    for (size_t i = 0; i < regularWalls.size(); ++i) {
+        if (isGateWallValid(regularWalls[i])) out.push_back(static_cast<int>(i));
+    }
+    if (out.size() >= 2) return true;
+
+    // 유효한 벽이 부족하면 테두리 벽 중에서 선택
+    out.clear();
+    for (size_t i = 0; i < regularWalls.size(); ++i) {
+        if (isBorderGateWall(regularWalls[i])) out.push_back(static_cast<int>(i));
+    }
+    return out.size() >= 2;
+}
+
 bool Map::isPositionValid(const Coord& pos) const
 {
     return pos.row >= 1 && pos.row < mapSize.height && 
@@ -285,86 +394,125 @@ bool Map::isPositionOccupied(const Coord& pos) const
     return false;
 }
 
-void Map::print_map() const
+void Map::resizeItems(Cell kind, size_t count)
 {
-    // 맵의 현재 상태를 출력
-    for (int i = 0; i < mapSize.height + 2; i++) {
-        for (int j = 0; j < mapSize.width + 2; j++) {
-            Coord pos{i, j};
-            bool printed = false;
-
-            // 테두리 출력
-            if (i == 0 || i == mapSize.height + 1 || j == 0 || j == mapSize.width + 1) {
-                cout << "#";
-                printed = true;
-                continue;
-            }
+    // 기존 아이템 칸 정리 후 개수 변경
+    for (size_t i = 0; i < itemCount(kind); ++i) {
+        const Coord& pos = itemCoord(kind, i);
+        if (occupancy.inBounds(pos) && itemIndex[occupancy.indexOf(pos)] == i + 1 && occupancy.groundAt(pos) == kind) {
+            itemIndex[occupancy.indexOf(pos)] = 0;
+            occupancy.setGround(pos, Cell::EMPTY);
+        }
+    }
+    switch (kind) {
+        case Cell::GROWTH: growthItems.assign(count, GrowthItem()); break;
+        case Cell::POISON: poisonItems.assign(count, PoisonItem()); break;
+        case Cell::TIME:   timeItems.assign(count, TimeItem()); break;
+        default: throw std::invalid_argument("Not an item cell");
+    }
+}
 
-            // 스네이크 헤드 출력
-            if (snakeHeadObject.coord == pos) {
-                cout << "H";
-                printed = true;
-                continue;
-            }
+size_t Map::itemCount(Cell kind) const
+{
+    switch (kind) {
+        case Cell::GROWTH: return growthItems.size();
+        case Cell::POISON: return poisonItems.size();
+        case Cell::TIME:   return timeItems.size();
+        default:           return 0;
+    }
+}
 
-            // 스네이크 바디 출력
-            for (const auto& body : snakeHeadObject.snakeBodySegments) {
-                if (body.coord == pos) {
-                    cout << "B";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 게이트 출력
-            for (const auto& gate : gameGates) {
-                if (gate.coord == pos && gate.isActive) {
-                    cout << "G";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 아이템 출력
-            if (growthItemObject.coord == pos) {
-                cout << "+";
-                printed = true;
-            } else if (poisonItemObject.coord == pos) {
-                cout << "-";
-                printed = true;
-            } else if (timeItemObject.coord == pos) {
-                cout << "T";
-                printed = true;
-            }
-            if (printed) continue;
-
-            // 벽 출력
-            for (const auto& wall : regularWalls) {
-                if (wall.coord == pos) {
-                    cout << "W";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 무적 벽 출력
-            for (const auto& wall : immuneWalls) {
-                if (wall.coord == pos) {
-                    cout << "I";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
+const Coord& Map::itemCoord(Cell kind, size_t index) const
+{
+    return const_cast<Map*>(this)->itemCoordRef(kind, index);
+}
+
+Coord& Map::itemCoordRef(Cell kind, size_t index)
+{
+    switch (kind) {
+        case Cell::GROWTH: return growthItems.at(index).coord;
+        case Cell::POISON: return poisonItems.at(index).coord;
+        case Cell::TIME:   return timeItems.at(index).coord;
+        default: throw std::invalid_argument("Not an item cell");
+    }
+}
+
+void Map::placeItem(Cell kind, size_t index, const Coord& to)
+{
+    unplaceItem(kind, index);
+    Coord& coord = itemCoordRef(kind, index);
+    uint32_t tag = static_cast<uint32_t>(index + 1);
+    coord = to;
+    if (occupancy.inBounds(to)) {
+        itemIndex[occupancy.indexOf(to)] = tag;
+        occupancy.setGround(to, kind);
+    }
+}
 
-            // 빈 공간 출력
-            cout << " ";
+void Map::unplaceItem(Cell kind, size_t index)
+{
+    Coord& coord = itemCoordRef(kind, index);
+    uint32_t tag = static_cast<uint32_t>(index + 1);
+    if (occupancy.inBounds(coord)) {
+        size_t from = occupancy.indexOf(coord);
+        if (itemIndex[from] == tag && occupancy.groundAt(coord) == kind) {
+            itemIndex[from] = 0;
+            occupancy.setGround(coord, Cell::EMPTY);
+        }
+    }
+    coord = Coord{0, 0};
+}
+
+int Map::itemAt(const Coord& pos) const
+{
+    if (!occupancy.inBounds(pos)) return -1;
+    Cell ground = occupancy.groundAt(pos);
+    if (ground != Cell::GROWTH && ground != Cell::POISON && ground != Cell::TIME) return -1;
+    return static_cast<int>(itemIndex[occupancy.indexOf(pos)]) - 1;
+}
+
+void Map::setGates(const Gate& first, const Gate& second)
+{
+    for (const auto& gate : gameGates) {
+        if (occupancy.groundAt(gate.coord) == Cell::GATE) {
+            occupancy.setGround(gate.coord, Cell::WALL);
+        }
+    }
+    gameGates[0] = first;
+    gameGates[1] = second;
+    occupancy.setGround(first.coord, Cell::GATE);
+    occupancy.setGround(second.coord, Cell::GATE);
+}
+
+void Map::rebuildOccupancy()
+{
+    occupancy.clearDynamic();
+    auto inside = [&](const Coord& pos) {
+        return pos.row >= 1 && pos.row <= mapSize.height && pos.col >= 1 && pos.col <= mapSize.width;
+    };
+    // 아이템은 아직 생성 전이면 (0, 0) 이므로 맵 안쪽일 때만 표시
+    std::fill(itemIndex.begin(), itemIndex.end(), 0);
+    for (Cell kind : {Cell::GROWTH, Cell::POISON, Cell::TIME}) {
+        for (size_t i = 0; i < itemCount(kind); ++i) {
+            const Coord& pos = itemCoord(kind, i);
+            if (!inside(pos)) continue;
+            occupancy.setGround(pos, kind);
+            itemIndex[occupancy.indexOf(pos)] = static_cast<uint32_t>(i + 1);
         }
-        cout << endl;
     }
+    for (const auto& body : snakeHeadObject.snakeBodySegments) {
+        occupancy.enterSnake(body.coord, Cell::BODY);
+    }
+    occupancy.enterSnake(snakeHeadObject.coord, Cell::HEAD);
+}
+
+void Map::print_map() const
+{
+    // 점유 격자를 한 번에 직렬화해서 출력 (칸마다 오브젝트 목록을 뒤지지 않음)
+    FrameSerializer serializer;
+    serializer.renderFull(occupancy);
+    cout.write(serializer.buffer(), static_cast<std::streamsize>(serializer.size()));
+    cout.flush();
 }
 
 #endif
\ No newline at end of file
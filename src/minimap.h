@@ -0,0 +1,182 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "grid.h"
+
+using namespace std;
+
+// 미니맵 한 칸(글리프)에 그릴 내용
+enum class MinimapGlyph : uint8_t {
+    EMPTY,
+    ITEM,
+    SOME_WALL,      // 블록 일부가 벽
+    WALL,           // 블록 절반 이상이 벽
+    BODY,
+    HEAD
+};
+
+// 큰 맵 미니맵용 블록 단위 점유 수 피라미드
+// - 0단계: 8x8칸 블록마다 벽·스네이크·아이템 칸 수, k단계: (8<<k)x(8<<k)칸 블록
+// - 칸이 바뀔 때(refresh) 그 칸의 이전 분류와 비교해 단계마다 블록 하나씩만 더하고 뺌 → O(단계 수)
+// - 화면에 그릴 때는 미니맵 판에 들어가는 가장 작은 단계를 골라 그 블록 수만큼만 읽음 → O(판 크기)
+// 매 프레임 맵 전체를 훑지 않으므로 큰 맵에서도 미니맵 비용은 일정
+class MinimapPyramid
+{
+public:
+    static constexpr int BASE_BLOCK = 8;
+    static constexpr int MAX_LEVELS = 12;
+
+    // 블록 집계·칸 분류 배열은 resource에서 받음
+    explicit MinimapPyramid(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : blocks(resource), cellKinds(resource) {}
+
+    // 격자 전체에서 다시 집계 (스테이지 시작 시)
+    void rebuild(const OccupancyGrid& grid);
+    // 격자에서 pos 칸이 바뀐 뒤 호출
+    void refresh(const OccupancyGrid& grid, const Coord& pos);
+
+    bool built() const { return levelCount > 0; }
+    // 블록이 maxRows x maxCols개 이하로 들어가는 가장 작은 단계 (그래도 넘으면 마지막 단계)
+    int levelFor(int maxRows, int maxCols) const;
+    int blockSize(int level) const { return BASE_BLOCK << level; }
+    int blockRows(int level) const { return levels[level].rows; }
+    int blockCols(int level) const { return levels[level].cols; }
+    MinimapGlyph glyph(int level, int row, int col) const;
+    // 단계 구성과 모든 블록의 분류별 칸 수가 같은지 (점진 갱신을 재구성 결과와 대조할 때)
+    bool operator==(const MinimapPyramid& other) const;
+
+private:
+    // 칸 분류 (집계 단위)
+    enum Kind : uint8_t { KIND_NONE, KIND_WALL, KIND_SNAKE, KIND_ITEM, KIND_COUNT };
+    struct Counts
+    {
+        uint32_t kinds[KIND_COUNT] = {0, 0, 0, 0};
+    };
+    struct Level
+    {
+        int rows = 0, cols = 0;
+        size_t first = 0;               // blocks에서 이 단계가 시작하는 위치
+    };
+
+    int gridRows = 0, gridCols = 0;
+    int levelCount = 0;
+    Level levels[MAX_LEVELS];
+    std::pmr::vector<Counts> blocks;        // 모든 단계의 블록 (0단계부터 이어 붙임, 행 우선)
+    std::pmr::vector<uint8_t> cellKinds;    // 칸마다 마지막으로 집계한 분류
+
+    static Kind classify(Cell cell);
+    void add(int row, int col, Kind kind, int delta);
+};
+
+MinimapPyramid::Kind MinimapPyramid::classify(Cell cell)
+{
+    switch (cell) {
+        case Cell::WALL:
+        case Cell::IMMUNE_WALL:
+        case Cell::GATE:
+            return KIND_WALL;
+        case Cell::HEAD:
+        case Cell::BODY:
+            return KIND_SNAKE;
+        case Cell::GROWTH:
+        case Cell::POISON:
+        case Cell::TIME:
+            return KIND_ITEM;
+        default:
+            return KIND_NONE;
+    }
+}
+
+void MinimapPyramid::rebuild(const OccupancyGrid& grid)
+{
+    gridRows = grid.rows();
+    gridCols = grid.cols();
+    // 블록이 1x1이 될 때까지 단계를 쌓음
+    levelCount = 0;
+    size_t total = 0;
+    while (levelCount < MAX_LEVELS) {
+        Level& level = levels[levelCount];
+        int size = blockSize(levelCount);
+        level.rows = (gridRows + size - 1) / size;
+        level.cols = (gridCols + size - 1) / size;
+        level.first = total;
+        total += (size_t)level.rows * level.cols;
+        levelCount++;
+        if (level.rows == 1 && level.cols == 1) break;
+    }
+    blocks.assign(total, Counts());
+    cellKinds.assign((size_t)gridRows * gridCols, KIND_NONE);
+    const Cell* cells = grid.data();
+    for (int row = 0; row < gridRows; ++row) {
+        for (int col = 0; col < gridCols; ++col) {
+            Kind kind = classify(cells[(size_t)row * gridCols + col]);
+            cellKinds[(size_t)row * gridCols + col] = kind;
+            if (kind != KIND_NONE) add(row, col, kind, 1);
+        }
+    }
+}
+
+void MinimapPyramid::refresh(const OccupancyGrid& grid, const Coord& pos)
+{
+    if (!grid.inBounds(pos) || pos.row >= gridRows || pos.col >= gridCols) return;
+    size_t index = (size_t)pos.row * gridCols + pos.col;
+    Kind now = classify(grid.at(pos));
+    Kind before = static_cast<Kind>(cellKinds[index]);
+    if (now == before) return;
+    cellKinds[index] = now;
+    if (before != KIND_NONE) add(pos.row, pos.col, before, -1);
+    if (now != KIND_NONE) add(pos.row, pos.col, now, 1);
+}
+
+void MinimapPyramid::add(int row, int col, Kind kind, int delta)
+{
+    for (int l = 0; l < levelCount; ++l) {
+        int size = blockSize(l);
+        const Level& level = levels[l];
+        blocks[level.first + (size_t)(row / size) * level.cols + col / size].kinds[kind] += delta;
+    }
+}
+
+int MinimapPyramid::levelFor(int maxRows, int maxCols) const
+{
+    for (int l = 0; l < levelCount; ++l) {
+        if (levels[l].rows <= maxRows && levels[l].cols <= maxCols) return l;
+    }
+    return levelCount - 1;
+}
+
+MinimapGlyph MinimapPyramid::glyph(int level, int row, int col) const
+{
+    const Level& lv = levels[level];
+    const Counts& counts = blocks[lv.first + (size_t)row * lv.cols + col];
+    // 블록이 격자 끝에 걸리면 실제 칸 수만큼만
+    int size = blockSize(level);
+    int cellRows = std::min(size, gridRows - row * size);
+    int cellCols = std::min(size, gridCols - col * size);
+    uint32_t area = (uint32_t)(cellRows * cellCols);
+    if (counts.kinds[KIND_SNAKE] > 0) return MinimapGlyph::BODY;
+    if (counts.kinds[KIND_WALL] * 2 >= area) return MinimapGlyph::WALL;
+    if (counts.kinds[KIND_ITEM] > 0) return MinimapGlyph::ITEM;
+    if (counts.kinds[KIND_WALL] > 0) return MinimapGlyph::SOME_WALL;
+    return MinimapGlyph::EMPTY;
+}
+
+bool MinimapPyramid::operator==(const MinimapPyramid& other) const
+{
+    if (gridRows != other.gridRows || gridCols != other.gridCols || levelCount != other.levelCount) return false;
+    if (cellKinds != other.cellKinds || blocks.size() != other.blocks.size()) return false;
+    for (int l = 0; l < levelCount; ++l) {
+        if (levels[l].rows != other.levels[l].rows || levels[l].cols != other.levels[l].cols) return false;
+    }
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!std::equal(blocks[i].kinds, blocks[i].kinds + KIND_COUNT, other.blocks[i].kinds)) return false;
+    }
+    return true;
+}
+
+#endif
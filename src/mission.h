@@ -0,0 +1,222 @@
+#ifndef MISSION_H
+#define MISSION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include "events.h"
+
+using namespace std;
+
+// 미션이 세는 값의 종류
+enum class MissionMetric : uint8_t {
+    SNAKE_LENGTH,   // 현재 길이 (줄어들면 달성이 취소됨)
+    GROWTH_ITEMS,
+    POISON_ITEMS,
+    TIME_ITEMS,
+    GATES_USED,
+    COUNT
+};
+
+// 미션 하나: metric 값이 target 이상이면 달성
+struct MissionGoal
+{
+    MissionMetric metric;
+    int target;
+};
+
+// 미션 보드에 쓰는 한 글자 표시
+inline char missionSymbol(MissionMetric metric)
+{
+    switch (metric) {
+        case MissionMetric::SNAKE_LENGTH: return 'B';
+        case MissionMetric::GROWTH_ITEMS: return '+';
+        case MissionMetric::POISON_ITEMS: return '-';
+        case MissionMetric::TIME_ITEMS:   return 'T';
+        case MissionMetric::GATES_USED:   return 'G';
+        default:                          return '?';
+    }
+}
+
+// 스테이지별 미션 표 (스테이지 번호 1부터)
+struct StageMissions
+{
+    const MissionGoal* goals;
+    size_t count;
+};
+
+const MissionGoal STAGE_1_GOALS[] = {
+    {MissionMetric::SNAKE_LENGTH, 7}, {MissionMetric::GROWTH_ITEMS, 5},
+    {MissionMetric::POISON_ITEMS, 2}, {MissionMetric::GATES_USED, 1},
+};
+const MissionGoal STAGE_2_GOALS[] = {
+    {MissionMetric::SNAKE_LENGTH, 7}, {MissionMetric::GROWTH_ITEMS, 5},
+    {MissionMetric::POISON_ITEMS, 2}, {MissionMetric::GATES_USED, 1},
+};
+const MissionGoal STAGE_3_GOALS[] = {
+    {MissionMetric::SNAKE_LENGTH, 7}, {MissionMetric::GROWTH_ITEMS, 5},
+    {MissionMetric::POISON_ITEMS, 2}, {MissionMetric::GATES_USED, 1},
+};
+const MissionGoal STAGE_4_GOALS[] = {
+    {MissionMetric::SNAKE_LENGTH, 7}, {MissionMetric::GROWTH_ITEMS, 5},
+    {MissionMetric::POISON_ITEMS, 2}, {MissionMetric::GATES_USED, 1},
+};
+
+inline StageMissions stageMissions(int stage)
+{
+    switch (stage) {
+        case 2:  return {STAGE_2_GOALS, sizeof(STAGE_2_GOALS) / sizeof(MissionGoal)};
+        case 3:  return {STAGE_3_GOALS, sizeof(STAGE_3_GOALS) / sizeof(MissionGoal)};
+        case 4:  return {STAGE_4_GOALS, sizeof(STAGE_4_GOALS) / sizeof(MissionGoal)};
+        default: return {STAGE_1_GOALS, sizeof(STAGE_1_GOALS) / sizeof(MissionGoal)};
+    }
+}
+
+// 사건을 받아 미션 달성 상태를 갱신
+// metric마다 목표값을 오름차순으로 정렬해두고 "아직 달성 못 한 첫 목표" 위치만 들고 있음
+// 값이 1 바뀔 때 그 위치 주변만 보면 되므로 미션 수와 무관하게 사건당 O(1) (같은 목표값이 여럿이면 그만큼)
+// 매 틱 전체를 다시 계산하지 않고, 달성/취소될 때만 MISSION_PROGRESS를 발행
+class MissionTracker : public GameEventSink
+{
+public:
+    explicit MissionTracker(EventQueue& events, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : events(events), goals(resource), thresholds(resource), achievedFlags(resource) {}
+
+    // 스테이지 시작 시 목표 교체 (벡터 용량은 유지되므로 이후 스테이지에서는 할당 없음)
+    void load(StageMissions missions, int initialLength);
+    // 디버그: 모든 목표를 달성한 값으로 맞춤
+    void completeAll();
+    // 목표·달성 상태를 other와 맞바꿈 (사건을 보낼 큐는 각자 유지, 같은 메모리 자원이면 O(1))
+    // 다음 스테이지 미션을 미리 load해 둔 추적기와 교체할 때 사용
+    void swap(MissionTracker& other);
+
+    bool complete() const { return achievedCount == goals.size(); }
+    size_t goalCount() const { return goals.size(); }
+    size_t achievedGoals() const { return achievedCount; }
+    const MissionGoal& goal(size_t index) const { return goals[index]; }
+    bool achieved(size_t index) const { return achievedFlags[index] != 0; }
+    int value(MissionMetric metric) const { return metrics[static_cast<size_t>(metric)].value; }
+
+    void onEvent(const GameEvent& event) override;
+
+private:
+    struct Threshold
+    {
+        int target;
+        uint16_t goal;      // goals 인덱스
+    };
+
+    // thresholds[begin, end)가 이 metric의 목표들, [begin, next)는 달성된 것
+    struct MetricTrack
+    {
+        int value = 0;
+        size_t begin = 0, end = 0, next = 0;
+    };
+
+    EventQueue& events;
+    std::pmr::vector<MissionGoal> goals;
+    std::pmr::vector<Threshold> thresholds;
+    std::pmr::vector<uint8_t> achievedFlags;
+    MetricTrack metrics[static_cast<size_t>(MissionMetric::COUNT)];
+    size_t achievedCount = 0;
+
+    void add(MissionMetric metric, int delta);
+    void setAchieved(uint16_t goal, bool value);
+};
+
+void MissionTracker::load(StageMissions missions, int initialLength)
+{
+    goals.assign(missions.goals, missions.goals + missions.count);
+    achievedFlags.assign(goals.size(), 0);
+    achievedCount = 0;
+
+    // metric별로 묶고 그 안에서 목표값 오름차순
+    thresholds.clear();
+    for (size_t i = 0; i < goals.size(); ++i) {
+        thresholds.push_back({goals[i].target, static_cast<uint16_t>(i)});
+    }
+    std::sort(thresholds.begin(), thresholds.end(), [this](const Threshold& a, const Threshold& b) {
+        MissionMetric ma = goals[a.goal].metric, mb = goals[b.goal].metric;
+        return ma != mb ? ma < mb : a.target < b.target;
+    });
+
+    for (auto& track : metrics) track = MetricTrack();
+    for (size_t i = 0; i < thresholds.size(); ++i) {
+        MetricTrack& track = metrics[static_cast<size_t>(goals[thresholds[i].goal].metric)];
+        if (track.begin == track.end) track.begin = track.next = i;
+        track.end = i + 1;
+    }
+    // 시작 길이만큼 반영 (목표값이 그 이하라면 처음부터 달성)
+    add(MissionMetric::SNAKE_LENGTH, initialLength);
+    // 목표값이 0 이하인 미션은 바로 달성
+    for (size_t m = 0; m < static_cast<size_t>(MissionMetric::COUNT); ++m) {
+        if (m != static_cast<size_t>(MissionMetric::SNAKE_LENGTH)) add(static_cast<MissionMetric>(m), 0);
+    }
+}
+
+void MissionTracker::completeAll()
+{
+    for (size_t m = 0; m < static_cast<size_t>(MissionMetric::COUNT); ++m) {
+        MetricTrack& track = metrics[m];
+        if (track.begin == track.end) continue;
+        int highest = thresholds[track.end - 1].target;
+        if (track.value < highest) add(static_cast<MissionMetric>(m), highest - track.value);
+    }
+}
+
+void MissionTracker::swap(MissionTracker& other)
+{
+    goals.swap(other.goals);
+    thresholds.swap(other.thresholds);
+    achievedFlags.swap(other.achievedFlags);
+    std::swap(metrics, other.metrics);
+    std::swap(achievedCount, other.achievedCount);
+}
+
+void MissionTracker::onEvent(const GameEvent& event)
+{
+    switch (event.type) {
+        case EventType::ITEM_CONSUMED:
+            if (event.item == ItemKind::GROWTH) {
+                add(MissionMetric::GROWTH_ITEMS, 1);
+                add(MissionMetric::SNAKE_LENGTH, 1);
+            } else if (event.item == ItemKind::POISON) {
+                add(MissionMetric::POISON_ITEMS, 1);
+                add(MissionMetric::SNAKE_LENGTH, -1);
+            } else {
+                add(MissionMetric::TIME_ITEMS, 1);
+            }
+            break;
+        case EventType::GATE_ENTERED:
+            add(MissionMetric::GATES_USED, 1);
+            break;
+        default:
+            break;
+    }
+}
+
+void MissionTracker::add(MissionMetric metric, int delta)
+{
+    MetricTrack& track = metrics[static_cast<size_t>(metric)];
+    track.value += delta;
+    while (track.next < track.end && thresholds[track.next].target <= track.value) {
+        setAchieved(thresholds[track.next].goal, true);
+        track.next++;
+    }
+    while (track.next > track.begin && thresholds[track.next - 1].target > track.value) {
+        track.next--;
+        setAchieved(thresholds[track.next].goal, false);
+    }
+}
+
+void MissionTracker::setAchieved(uint16_t goal, bool value)
+{
+    achievedFlags[goal] = value ? 1 : 0;
+    if (value) achievedCount++; else achievedCount--;
+    events.emit(GameEvent::forMission(goal, value));
+}
+
+#endif
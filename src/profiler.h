@@ -0,0 +1,177 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+// 계측 빌드(-DSNAKE_INSTRUMENT)에서만 증가하는 전역 힙 할당 카운터
+// main.cpp의 operator new 교체 함수가 증가시킴
+inline std::atomic<uint64_t> heapAllocationCount{0};
+
+// 틱에 어떤 일이 있었는지 표시하는 플래그 (프레임 튀는 원인 추적용)
+enum TickMark : uint8_t {
+    TICK_MARK_STAGE_RESET = 1 << 0,
+    TICK_MARK_GATE_REGEN  = 1 << 1,
+    TICK_MARK_ITEM_SPAWN  = 1 << 2,
+    TICK_MARK_GAME_OVER   = 1 << 3,
+    TICK_MARK_MISSION     = 1 << 4
+};
+
+// 이 틱 뒤에 모달 화면(Game Over, 미션 완료)이 떠서 다음 틱까지의 간격에 사람이 기다린 시간이 들어간 틱
+constexpr uint8_t TICK_MARK_MODAL = TICK_MARK_GAME_OVER | TICK_MARK_MISSION;
+
+struct TickSample
+{
+    uint32_t tick;
+    uint32_t allocations;   // 이 틱 시작부터 다음 틱 시작까지의 operator new 호출 수
+    float workMs;           // 틱 처리(입력·업데이트·그리기)에 걸린 시간
+    float intervalMs;       // 다음 틱 시작까지 실제 걸린 시간
+    float targetMs;         // 의도한 틱 간격 (gameSpeedDelay / speedMultiplier)
+    uint8_t stage;
+    uint8_t marks;
+};
+
+// 틱 지연·지터·할당 수 기록기
+// 버퍼는 생성 시 한 번만 확보하고 가득 차면 링 버퍼처럼 덮어씀
+class TickProfiler
+{
+public:
+    explicit TickProfiler(size_t capacity = 1 << 16);
+
+    void beginTick(int stage);
+    void endTick(float targetMs);
+    void mark(uint8_t flags);
+    // 기록된 시계열을 CSV로 출력 (경로: $SNAKE_PROFILE_OUT, 기본 snake_profile.csv)
+    void dump(const char* exitReason) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<TickSample> samples;
+    size_t nextIndex = 0;
+    uint32_t tickCount = 0;
+    bool inTick = false;
+    Clock::time_point tickStart;
+    uint64_t allocationsAtStart = 0;
+
+    TickSample* currentSample();
+};
+
+TickProfiler::TickProfiler(size_t capacity)
+    : samples(capacity > 0 ? capacity : 1)
+{
+}
+
+TickSample* TickProfiler::currentSample()
+{
+    if (tickCount == 0) return nullptr;
+    return &samples[(nextIndex + samples.size() - 1) % samples.size()];
+}
+
+void TickProfiler::beginTick(int stage)
+{
+    Clock::time_point now = Clock::now();
+    uint64_t allocations = heapAllocationCount.load(std::memory_order_relaxed);
+
+    // 직전 틱의 실제 간격과 할당 수는 이번 틱 시작 시점에 확정됨
+    if (TickSample* prev = currentSample()) {
+        prev->intervalMs = std::chrono::duration<float, std::milli>(now - tickStart).count();
+        prev->allocations = static_cast<uint32_t>(allocations - allocationsAtStart);
+    }
+
+    TickSample& sample = samples[nextIndex];
+    nextIndex = (nextIndex + 1) % samples.size();
+    sample = TickSample{tickCount++, 0, 0.0f, 0.0f, 0.0f, static_cast<uint8_t>(stage), 0};
+
+    tickStart = now;
+    allocationsAtStart = allocations;
+    inTick = true;
+}
+
+void TickProfiler::endTick(float targetMs)
+{
+    TickSample* sample = currentSample();
+    if (!sample || !inTick) return;
+    sample->workMs = std::chrono::duration<float, std::milli>(Clock::now() - tickStart).count();
+    sample->targetMs = targetMs;
+    inTick = false;
+}
+
+void TickProfiler::mark(uint8_t flags)
+{
+    if (TickSample* sample = currentSample()) {
+        sample->marks |= flags;
+    }
+}
+
+void TickProfiler::dump(const char* exitReason) const
+{
+    const char* path = std::getenv("SNAKE_PROFILE_OUT");
+    if (!path || !*path) path = "snake_profile.csv";
+
+    FILE* out = std::fopen(path, "w");
+    if (!out) return;
+
+    size_t count = tickCount < samples.size() ? tickCount : samples.size();
+    size_t first = (nextIndex + samples.size() - count) % samples.size();
+
+    // 요약: 마지막 틱은 간격이 확정되지 않았으므로 제외
+    // 모달 화면을 띄운 틱은 작업 시간·할당만 세고 지터에서는 뺌 (간격이 화면에 머문 시간이므로)
+    double jitterSum = 0, jitterMax = 0, workMax = 0;
+    uint64_t allocationTotal = 0;
+    size_t measured = 0, jitterMeasured = 0;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        const TickSample& s = samples[(first + i) % samples.size()];
+        if (s.workMs > workMax) workMax = s.workMs;
+        allocationTotal += s.allocations;
+        measured++;
+        if (s.marks & TICK_MARK_MODAL) continue;
+        double jitter = s.intervalMs - s.targetMs;
+        if (jitter < 0) jitter = -jitter;
+        jitterSum += jitter;
+        if (jitter > jitterMax) jitterMax = jitter;
+        jitterMeasured++;
+    }
+
+    std::fprintf(out, "# exit: %s\n", exitReason);
+    std::fprintf(out, "# ticks: %u (kept %zu)\n", tickCount, count);
+    if (measured > 0) {
+        std::fprintf(out, "# jitter_ms: mean %.3f max %.3f\n", jitterMeasured ? jitterSum / jitterMeasured : 0.0, jitterMax);
+        std::fprintf(out, "# work_ms: max %.3f\n", workMax);
+        std::fprintf(out, "# allocations: total %llu\n", (unsigned long long)allocationTotal);
+    }
+    std::fprintf(out, "tick,stage,allocations,work_ms,interval_ms,target_ms,jitter_ms,stage_reset,gate_regen,item_spawn,game_over,mission\n");
+    for (size_t i = 0; i < count; ++i) {
+        const TickSample& s = samples[(first + i) % samples.size()];
+        std::fprintf(out, "%u,%u,%u,%.3f,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d\n",
+                     s.tick, s.stage, s.allocations, s.workMs, s.intervalMs, s.targetMs,
+                     s.intervalMs - s.targetMs,
+                     (s.marks & TICK_MARK_STAGE_RESET) != 0,
+                     (s.marks & TICK_MARK_GATE_REGEN) != 0,
+                     (s.marks & TICK_MARK_ITEM_SPAWN) != 0,
+                     (s.marks & TICK_MARK_GAME_OVER) != 0,
+                     (s.marks & TICK_MARK_MISSION) != 0);
+    }
+    std::fclose(out);
+}
+
+// 일반 빌드에서는 계측 코드가 전부 사라짐
+#ifdef SNAKE_INSTRUMENT
+#define SNAKE_PROFILE_BEGIN(stage) tickProfiler.beginTick(stage)
+#define SNAKE_PROFILE_END(targetMs) tickProfiler.endTick(targetMs)
+#define SNAKE_PROFILE_MARK(flags) tickProfiler.mark(flags)
+#define SNAKE_PROFILE_DUMP(reason) tickProfiler.dump(reason)
+#else
+#define SNAKE_PROFILE_BEGIN(stage) ((void)0)
+#define SNAKE_PROFILE_END(targetMs) ((void)0)
+#define SNAKE_PROFILE_MARK(flags) ((void)0)
+#define SNAKE_PROFILE_DUMP(reason) ((void)0)
+#endif
+
+#endif
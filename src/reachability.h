@@ -0,0 +1,383 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <vector>
+#include "grid.h"
+
+using namespace std;
+
+// 빈 공간(스네이크가 지나갈 수 있는 칸)의 연결 요소 라벨을 점진적으로 유지
+// - 지나갈 수 있는 칸: 스네이크가 없고 바닥이 빈 칸 또는 아이템
+// - 칸이 막힐 때(머리 진입): 주변 8칸 고리가 끊기지 않으면 O(1). 끊길 수 있으면 양쪽에서 번갈아
+//   BFS를 돌려 먼저 끝나는 쪽(작은 쪽)만 새 라벨로 바꿈 → 비용은 작은 조각 크기
+// - 칸이 열릴 때(꼬리 이탈): 이웃 라벨이 여럿이면 작은 요소를 큰 요소 라벨로 바꿈
+// 매 틱 전체 BFS를 하지 않으므로 큰 맵에서도 틱당 비용은 대부분 상수
+// 게이트는 막힌 칸으로 두고, 게이트 쌍으로 이어지는 요소는 reachableFrom()에서 합쳐 봄
+class ReachabilityMap
+{
+public:
+    static constexpr uint32_t BLOCKED = 0;
+
+    // 시작 위치에서 닿는 요소들 (머리 4방향 + 게이트 건너편)
+    struct ReachableSet
+    {
+        static constexpr int MAX_LABELS = 12;
+        uint32_t labels[MAX_LABELS];
+        int count = 0;
+        int area = 0;       // 요소 크기 합
+
+        bool contains(uint32_t label) const
+        {
+            for (int i = 0; i < count; ++i) {
+                if (labels[i] == label) return true;
+            }
+            return false;
+        }
+    };
+
+    explicit ReachabilityMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // 격자 전체를 다시 라벨링 (스테이지 시작 시)
+    void rebuild(const OccupancyGrid& grid);
+    // 격자에서 pos 칸이 바뀐 뒤 호출: 통과 가능 여부가 달라졌으면 라벨 갱신
+    void refresh(const OccupancyGrid& grid, const Coord& pos);
+
+    uint32_t label(const Coord& pos) const { return inBounds(pos) ? labels[indexOf(pos)] : BLOCKED; }
+    int componentSize(uint32_t label) const { return label == BLOCKED ? 0 : sizes[label]; }
+    size_t componentCount() const { return liveComponents; }
+
+    // head에서 한 칸 움직여 들어갈 수 있는 요소들. gates가 있으면 한쪽 출구 요소에 닿을 때 반대쪽 출구 요소도 포함
+    template <typename GateList>
+    ReachableSet reachableFrom(const Coord& head, const GateList& gates) const;
+
+    // 스네이크가 갇혔는지: 닿는 공간이 꼬리가 빠져나가 길이 열리기 전에 바닥나면 true
+    // body는 머리 다음 마디부터 꼬리까지 (아이템을 먹어 꼬리가 늦게 빠지는 경우는 고려하지 않음)
+    template <typename GateList, typename BodyList>
+    bool doomed(const Coord& head, const GateList& gates, const BodyList& body) const;
+
+private:
+    int gridRows = 0, gridCols = 0;
+    std::pmr::vector<uint32_t> labels;      // 칸별 요소 라벨 (BLOCKED면 막힘)
+    std::pmr::vector<int> sizes;            // 라벨별 칸 수
+    std::pmr::vector<uint32_t> freeLabels;  // 재사용할 라벨
+    size_t liveComponents = 0;
+    // 분할 검사용 BFS 작업 공간 (워밍업 후 재할당 없음)
+    std::pmr::vector<uint32_t> marks;
+    uint32_t epoch = 0;
+    std::pmr::vector<int> queueA, queueB;
+
+    bool inBounds(const Coord& pos) const
+    {
+        return pos.row >= 0 && pos.row < gridRows && pos.col >= 0 && pos.col < gridCols;
+    }
+    size_t indexOf(const Coord& pos) const { return (size_t)pos.row * gridCols + pos.col; }
+    static bool passable(const OccupancyGrid& grid, const Coord& pos);
+
+    uint32_t newLabel();
+    void releaseLabel(uint32_t label);
+    void block(const Coord& pos);
+    void unblock(const Coord& pos);
+    // start 칸이 속한 요소 전체를 to로 바꿈
+    void relabel(int start, uint32_t to);
+    // 같은 라벨의 두 칸이 아직 이어져 있는지 번갈아 BFS. 끊겼으면 먼저 끝난 쪽을 새 라벨로 분리
+    void splitIfDisconnected(int a, int b);
+    void nextEpoch();
+};
+
+ReachabilityMap::ReachabilityMap(std::pmr::memory_resource* resource)
+    : labels(resource), sizes(resource), freeLabels(resource)
+    , marks(resource), queueA(resource), queueB(resource)
+{
+}
+
+bool ReachabilityMap::passable(const OccupancyGrid& grid, const Coord& pos)
+{
+    if (!grid.inBounds(pos) || grid.snakeCount(pos) > 0) return false;
+    Cell ground = grid.groundAt(pos);
+    return ground == Cell::EMPTY || ground == Cell::GROWTH || ground == Cell::POISON || ground == Cell::TIME;
+}
+
+uint32_t ReachabilityMap::newLabel()
+{
+    liveComponents++;
+    if (!freeLabels.empty()) {
+        uint32_t label = freeLabels.back();
+        freeLabels.pop_back();
+        sizes[label] = 0;
+        return label;
+    }
+    sizes.push_back(0);
+    return static_cast<uint32_t>(sizes.size() - 1);
+}
+
+void ReachabilityMap::releaseLabel(uint32_t label)
+{
+    liveComponents--;
+    sizes[label] = 0;
+    freeLabels.push_back(label);
+}
+
+void ReachabilityMap::nextEpoch()
+{
+    epoch += 2;
+    if (epoch < 2) {
+        // 한 바퀴 돌았으면 표시를 지우고 다시 시작
+        std::fill(marks.begin(), marks.end(), 0);
+        epoch = 2;
+    }
+}
+
+void ReachabilityMap::rebuild(const OccupancyGrid& grid)
+{
+    gridRows = grid.rows();
+    gridCols = grid.cols();
+    size_t cellCount = (size_t)gridRows * gridCols;
+    labels.assign(cellCount, BLOCKED);
+    marks.assign(cellCount, 0);
+    epoch = 0;
+    queueA.reserve(cellCount);
+    queueB.reserve(cellCount);
+    sizes.assign(1, 0);     // 0번은 BLOCKED
+    freeLabels.clear();
+    liveComponents = 0;
+
+    for (int row = 0; row < gridRows; ++row) {
+        for (int col = 0; col < gridCols; ++col) {
+            Coord pos{row, col};
+            if (passable(grid, pos)) labels[indexOf(pos)] = UINT32_MAX;     // 아직 라벨 없음
+        }
+    }
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    for (size_t start = 0; start < cellCount; ++start) {
+        if (labels[start] != UINT32_MAX) continue;
+        uint32_t label = newLabel();
+        queueA.clear();
+        queueA.push_back((int)start);
+        labels[start] = label;
+        for (size_t head = 0; head < queueA.size(); ++head) {
+            int index = queueA[head];
+            for (int d = 0; d < 4; ++d) {
+                Coord next{index / gridCols + dr[d], index % gridCols + dc[d]};
+                if (!inBounds(next) || labels[indexOf(next)] != UINT32_MAX) continue;
+                labels[indexOf(next)] = label;
+                queueA.push_back((int)indexOf(next));
+            }
+        }
+        sizes[label] = (int)queueA.size();
+    }
+}
+
+void ReachabilityMap::refresh(const OccupancyGrid& grid, const Coord& pos)
+{
+    if (!inBounds(pos)) return;
+    bool open = passable(grid, pos);
+    bool tracked = labels[indexOf(pos)] != BLOCKED;
+    if (open && !tracked) {
+        unblock(pos);
+    } else if (!open && tracked) {
+        block(pos);
+    }
+}
+
+void ReachabilityMap::unblock(const Coord& pos)
+{
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    // 가장 큰 이웃 요소에 합치고 나머지는 그 라벨로 바꿈 (작은 쪽만 다시 칠하므로 총비용 O(n log n))
+    uint32_t target = BLOCKED;
+    for (int d = 0; d < 4; ++d) {
+        uint32_t neighbor = label(Coord{pos.row + dr[d], pos.col + dc[d]});
+        if (neighbor != BLOCKED && (target == BLOCKED || sizes[neighbor] > sizes[target])) target = neighbor;
+    }
+    if (target == BLOCKED) target = newLabel();
+    labels[indexOf(pos)] = target;
+    sizes[target]++;
+    for (int d = 0; d < 4; ++d) {
+        Coord next{pos.row + dr[d], pos.col + dc[d]};
+        uint32_t neighbor = label(next);
+        if (neighbor != BLOCKED && neighbor != target) {
+            sizes[target] += sizes[neighbor];
+            releaseLabel(neighbor);
+            relabel((int)indexOf(next), target);
+        }
+    }
+}
+
+void ReachabilityMap::relabel(int start, uint32_t to)
+{
+    uint32_t from = labels[start];
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    queueA.clear();
+    queueA.push_back(start);
+    labels[start] = to;
+    for (size_t head = 0; head < queueA.size(); ++head) {
+        int index = queueA[head];
+        for (int d = 0; d < 4; ++d) {
+            Coord next{index / gridCols + dr[d], index % gridCols + dc[d]};
+            if (!inBounds(next) || labels[indexOf(next)] != from) continue;
+            labels[indexOf(next)] = to;
+            queueA.push_back((int)indexOf(next));
+        }
+    }
+}
+
+void ReachabilityMap::block(const Coord& pos)
+{
+    size_t index = indexOf(pos);
+    uint32_t label = labels[index];
+    labels[index] = BLOCKED;
+    if (--sizes[label] == 0) {
+        releaseLabel(label);
+        return;
+    }
+
+    // 주변 8칸을 시계 방향으로 돌며 열린 칸의 연속 구간을 찾음
+    // 한 구간 안의 상하좌우 이웃은 서로 이어져 있으므로, 상하좌우 이웃이 모두 한 구간에 있으면 분할 없음
+    static const int ringRow[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    static const int ringCol[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+    bool open[8];
+    for (int i = 0; i < 8; ++i) open[i] = this->label(Coord{pos.row + ringRow[i], pos.col + ringCol[i]}) == label;
+
+    // 구간마다 대표 상하좌우 이웃 하나씩
+    int representatives[4];
+    int runCount = 0;
+    int startAt = 0;
+    while (startAt < 8 && open[startAt]) startAt++;
+    if (startAt == 8) return;   // 주변이 모두 열려 있음
+    bool inRun = false;
+    bool runHasOrthogonal = false;
+    for (int step = 1; step <= 8; ++step) {
+        int i = (startAt + step) % 8;
+        if (open[i]) {
+            if (!inRun) { inRun = true; runHasOrthogonal = false; }
+            if (i % 2 == 0 && !runHasOrthogonal) {
+                runHasOrthogonal = true;
+                representatives[runCount++] = (int)indexOf(Coord{pos.row + ringRow[i], pos.col + ringCol[i]});
+            }
+        } else {
+            inRun = false;
+        }
+    }
+    // 대각선 칸만 있는 구간은 상하좌우 이웃이 아니므로 대표가 없음
+    // 아직 같은 라벨인 대표 쌍마다 연결을 확인 (분리되면 라벨이 달라져 이후 쌍은 건너뜀)
+    for (int i = 0; i < runCount; ++i) {
+        for (int j = i + 1; j < runCount; ++j) {
+            if (labels[representatives[i]] == labels[representatives[j]]) {
+                splitIfDisconnected(representatives[i], representatives[j]);
+            }
+        }
+    }
+}
+
+void ReachabilityMap::splitIfDisconnected(int a, int b)
+{
+    uint32_t label = labels[a];
+    nextEpoch();
+    uint32_t markA = epoch, markB = epoch + 1;
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    queueA.clear();
+    queueB.clear();
+    queueA.push_back(a);
+    queueB.push_back(b);
+    marks[a] = markA;
+    marks[b] = markB;
+    size_t headA = 0, headB = 0;
+
+    // 한 칸씩 번갈아 확장: 만나면 연결, 한쪽이 먼저 끝나면 그쪽이 떨어져 나간 작은 요소
+    while (true) {
+        for (int side = 0; side < 2; ++side) {
+            std::pmr::vector<int>& queue = side == 0 ? queueA : queueB;
+            size_t& head = side == 0 ? headA : headB;
+            uint32_t own = side == 0 ? markA : markB;
+            uint32_t other = side == 0 ? markB : markA;
+            if (head == queue.size()) {
+                // 이 쪽이 닫힘: 방문한 칸을 새 라벨로
+                uint32_t split = newLabel();
+                for (int index : queue) labels[index] = split;
+                sizes[split] = (int)queue.size();
+                sizes[label] -= (int)queue.size();
+                return;
+            }
+            int index = queue[head++];
+            for (int d = 0; d < 4; ++d) {
+                Coord next{index / gridCols + dr[d], index % gridCols + dc[d]};
+                if (!inBounds(next)) continue;
+                size_t nextIndex = indexOf(next);
+                if (labels[nextIndex] != label) continue;
+                if (marks[nextIndex] == other) return;  // 만남
+                if (marks[nextIndex] == own) continue;
+                marks[nextIndex] = own;
+                queue.push_back((int)nextIndex);
+            }
+        }
+    }
+}
+
+template <typename GateList>
+ReachabilityMap::ReachableSet ReachabilityMap::reachableFrom(const Coord& head, const GateList& gates) const
+{
+    ReachableSet set;
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    auto add = [&](uint32_t value) {
+        if (value == BLOCKED || set.contains(value) || set.count == ReachableSet::MAX_LABELS) return false;
+        set.labels[set.count++] = value;
+        set.area += sizes[value];
+        return true;
+    };
+    for (int d = 0; d < 4; ++d) add(label(Coord{head.row + dr[d], head.col + dc[d]}));
+    // 게이트 출구가 이미 닿는 요소에 붙어 있으면 반대쪽 게이트 출구 요소도 닿음 (새로 추가되면 한 번 더 확인)
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (size_t g = 0; g < gates.size(); ++g) {
+            const Coord& gate = gates[g].coord;
+            bool touches = false;
+            for (int d = 0; d < 4; ++d) {
+                if (set.contains(label(Coord{gate.row + dr[d], gate.col + dc[d]}))) touches = true;
+            }
+            if (!touches) continue;
+            for (size_t o = 0; o < gates.size(); ++o) {
+                if (o == g) continue;
+                const Coord& exit = gates[o].coord;
+                for (int d = 0; d < 4; ++d) {
+                    if (add(label(Coord{exit.row + dr[d], exit.col + dc[d]}))) changed = true;
+                }
+            }
+        }
+    }
+    return set;
+}
+
+template <typename GateList, typename BodyList>
+bool ReachabilityMap::doomed(const Coord& head, const GateList& gates, const BodyList& body) const
+{
+    ReachableSet set = reachableFrom(head, gates);
+    int dr[4] = {-1, 1, 0, 0};
+    int dc[4] = {0, 0, -1, 1};
+    // i번 마디(0이 목)는 (길이 - i)틱 뒤에 비워짐
+    // 닿는 공간 안에서 그만큼 버틸 수 있고 그 마디가 닿는 공간(또는 머리)에 붙어 있으면 빠져나갈 길이 생김
+    size_t length = body.size();
+    for (size_t i = length; i-- > 0;) {
+        int vacateAfter = static_cast<int>(length - i);
+        if (vacateAfter > set.area + 1) break;
+        const Coord& segment = body[i].coord;
+        if (segment == head) continue;
+        // 다음 틱에 비는 꼬리는 머리 바로 옆이기만 하면 됨
+        if (vacateAfter == 1 && std::abs(segment.row - head.row) + std::abs(segment.col - head.col) == 1) return false;
+        for (int d = 0; d < 4; ++d) {
+            if (set.contains(label(Coord{segment.row + dr[d], segment.col + dc[d]}))) return false;
+        }
+    }
+    // 꼬리가 열리기 전에 공간이 바닥남. 단, 공간이 몸 길이 이상이면 돌면서 버틸 수 있음
+    return set.area < static_cast<int>(length);
+}
+
+#endif
@@ -0,0 +1,361 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <ncurses.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "snapshot.h"
+#include "viewport.h"
+
+using namespace std;
+
+// RAII 패턴을 위한 ncurses 윈도우 래퍼 클래스
+class WindowWrapper {
+private:
+    WINDOW* window;
+    
+public:
+    WindowWrapper(int height, int width, int starty, int startx) 
+        : window(newwin(height, width, starty, startx)) {
+        if (!window) {
+            throw std::runtime_error("Failed to create ncurses window");
+        }
+    }
+    
+    ~WindowWrapper() {
+        if (window) {
+            delwin(window);
+        }
+    }
+
+    // 화면 위치가 없는 pad (pnoutrefresh로 원하는 부분만 원하는 자리에 출력)
+    static WindowWrapper pad(int height, int width) {
+        WINDOW* created = newpad(height, width);
+        if (!created) {
+            throw std::runtime_error("Failed to create ncurses pad");
+        }
+        return WindowWrapper(created);
+    }
+    
+    // 복사 방지
+    WindowWrapper(const WindowWrapper&) = delete;
+    WindowWrapper& operator=(const WindowWrapper&) = delete;
+    
+    // 이동 생성자/대입 연산자
+    WindowWrapper(WindowWrapper&& other) noexcept : window(other.window) {
+        other.window = nullptr;
+    }
+    
+    WindowWrapper& operator=(WindowWrapper&& other) noexcept {
+        if (this != &other) {
+            if (window) {
+                delwin(window);
+            }
+            window = other.window;
+            other.window = nullptr;
+        }
+        return *this;
+    }
+    
+    WINDOW* get() const { return window; }
+    operator WINDOW*() const { return window; }
+
+private:
+    explicit WindowWrapper(WINDOW* created) : window(created) {}
+};
+
+// 화면 출력 전용 스레드
+// 시뮬레이션 스레드가 publish()한 최신 FrameSnapshot만 그림 (밀린 프레임은 건너뜀)
+// 시뮬레이션이 아무리 빨라도 화면 갱신은 REFRESH_HZ를 넘지 않음
+// 머리가 다음 칸으로 절반 이상 진행하면(보간 alpha >= 0.5) 앞 칸에 표시를 더해 한 번 더 그림
+// 터미널 출력이 느려도(SSH 등) 시뮬레이션 틱 간격에는 영향이 없음
+// ncurses는 스레드 안전하지 않으므로 동작 중에는 다른 스레드에서 ncurses를 호출하면 안 됨
+// (Game Over 등 모달 화면 전에는 stop(), 돌아오면 start())
+// 보드는 보이는 영역(viewRows x viewCols) 크기의 pad에 스냅샷의 보이는 칸만 그림
+// → 그리는 비용은 맵 크기가 아니라 터미널 크기에 비례
+// withMinimap이면 미션판 오른쪽에 미니맵 판도 그림 (스냅샷의 미니맵 글리프 그대로)
+class Renderer
+{
+public:
+    Renderer(int viewRows, int viewCols, bool withMinimap = false);
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    void start();
+    void stop();
+    bool running() const { return active.load(); }
+
+    // 시뮬레이션 스레드 전용
+    FrameSnapshot& writeBuffer() { return frames.writeBuffer(); }
+    void publish();
+
+    static const int REFRESH_HZ = 60;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    TripleBuffer<FrameSnapshot> frames;
+    WindowWrapper board;
+    WindowWrapper score;
+    WindowWrapper mission;
+    std::optional<WindowWrapper> minimap;
+    std::thread worker;
+    std::atomic<bool> active{false};
+    int wakeFd = -1;    // 새 프레임 도착 또는 종료 요청
+    uint32_t playedCues = 0;
+    Clock::time_point interpolateAt = Clock::time_point::max();    // 보간 표시가 바뀌는 시각
+
+    void run();
+    void draw(const FrameSnapshot& frame, Clock::time_point now);
+    static void drawBoard(WINDOW* board, const FrameSnapshot& frame, double alpha);
+    static void drawScore(WINDOW* score, const FrameSnapshot& frame);
+    static void drawMission(WINDOW* mission, const FrameSnapshot& frame);
+    static void drawMinimap(WINDOW* minimap, const FrameSnapshot& frame);
+};
+
+Renderer::Renderer(int viewRows, int viewCols, bool withMinimap)
+    : board(WindowWrapper::pad(viewRows + 2, viewCols + 2))
+    , score(9, 27, 0, viewCols + 4)
+    , mission(9, 27, 10, viewCols + 4)
+{
+    if (withMinimap) {
+        minimap.emplace(Viewport::MINIMAP_HEIGHT, Viewport::MINIMAP_WIDTH, 0, viewCols + 4 + Viewport::MINIMAP_COLUMNS);
+    }
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) {
+        throw std::runtime_error("Failed to create renderer eventfd");
+    }
+}
+
+Renderer::~Renderer()
+{
+    stop();
+    close(wakeFd);
+}
+
+void Renderer::start()
+{
+    if (active.exchange(true)) return;
+    // 모달 화면이 덮어쓴 부분까지 전부 다시 그리도록 표시
+    clearok(curscr, TRUE);
+    worker = std::thread(&Renderer::run, this);
+}
+
+void Renderer::stop()
+{
+    if (!active.exchange(false)) return;
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+    worker.join();
+}
+
+void Renderer::publish()
+{
+    frames.publish();
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void Renderer::run()
+{
+    const Clock::duration frameInterval = std::chrono::microseconds(1000000 / REFRESH_HZ);
+    // 시작 직후에는 새 프레임이 없어도 마지막 프레임을 한 번 그림
+    frames.update();
+    draw(frames.readBuffer(), Clock::now());
+    Clock::time_point nextAllowed = Clock::now() + frameInterval;
+    bool pending = false;   // 새 프레임이 왔지만 갱신률 제한으로 아직 못 그림
+    while (active.load()) {
+        Clock::time_point wakeAt = pending ? nextAllowed : interpolateAt;
+        int timeout = -1;
+        if (wakeAt != Clock::time_point::max()) {
+            auto wait = std::chrono::ceil<std::chrono::milliseconds>(wakeAt - Clock::now()).count();
+            timeout = wait > 0 ? static_cast<int>(wait) : 0;
+        }
+        pollfd pfd{wakeFd, POLLIN, 0};
+        int r = poll(&pfd, 1, timeout);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (r > 0) {
+            uint64_t count;
+            ssize_t ignored = read(wakeFd, &count, sizeof(count));
+            (void)ignored;
+            pending = true;
+        }
+        if (!active.load()) break;
+
+        Clock::time_point now = Clock::now();
+        if (now < nextAllowed) continue;
+        bool fresh = frames.update();
+        if (fresh || now >= interpolateAt) {
+            draw(frames.readBuffer(), now);
+            nextAllowed = now + frameInterval;
+        }
+        pending = false;
+    }
+}
+
+void Renderer::draw(const FrameSnapshot& frame, Clock::time_point now)
+{
+    if (frame.cells.empty()) return;
+    werase(board.get());
+    werase(score.get());
+    werase(mission.get());
+
+    box(board.get(), 0, 0);
+    box(score.get(), 0, 0);
+    box(mission.get(), 0, 0);
+
+    // 보간: 절반을 넘기 전이면 넘는 시각에 다시 그리도록 예약
+    double alpha = frame.moveAlpha(now);
+    interpolateAt = Clock::time_point::max();
+    if (frame.movePeriod > Clock::duration::zero() && alpha < 0.5) {
+        interpolateAt = frame.moveStart + frame.movePeriod / 2;
+    }
+    drawBoard(board.get(), frame, alpha);
+    drawScore(score.get(), frame);
+    drawMission(mission.get(), frame);
+    if (minimap) {
+        werase(minimap->get());
+        box(minimap->get(), 0, 0);
+        drawMinimap(minimap->get(), frame);
+    }
+
+    // 세 윈도우를 모아 터미널에는 한 번만 출력 (보드 pad는 테두리 포함 전체를 화면 왼쪽 위에)
+    wnoutrefresh(stdscr);
+    pnoutrefresh(board.get(), 0, 0, 0, 0, frame.rows + 1, frame.cols + 1);
+    wnoutrefresh(score.get());
+    wnoutrefresh(mission.get());
+    if (minimap) wnoutrefresh(minimap->get());
+    doupdate();
+
+    // 효과음은 시뮬레이션 스레드가 아니라 여기서 냄 (일부 터미널에서 beep가 블로킹됨)
+    if (frame.soundCues != playedCues) {
+        playedCues = frame.soundCues;
+        beep();
+    }
+}
+
+void Renderer::drawBoard(WINDOW* board, const FrameSnapshot& frame, double alpha)
+{
+    // 머리 방향 문자
+    char headChar = 'O';
+    switch (frame.headDirection) {
+        case 1: headChar = '^'; break;
+        case 2: headChar = '<'; break;
+        case 3: headChar = '>'; break;
+        case 4: headChar = 'v'; break;
+    }
+    // 보이는 영역 (row, col) → 창 (row + 1, col + 1), 테두리는 box()
+    Coord tail{frame.tail.row - frame.originRow, frame.tail.col - frame.originCol};
+    for (int row = 0; row < frame.rows; ++row) {
+        for (int col = 0; col < frame.cols; ++col) {
+            int color = 0;
+            chtype glyph = ' ';
+            switch (frame.at(row, col)) {
+                case Cell::WALL:        color = 2; glyph = ' '; break;
+                case Cell::IMMUNE_WALL: color = 2; glyph = '+'; break;
+                case Cell::GATE:        color = 7; glyph = ' '; break;
+                case Cell::HEAD:        color = 3; glyph = headChar | A_BOLD; break;
+                case Cell::BODY:
+                    // 꼬리만 따로 색상
+                    if (tail.row == row && tail.col == col) {
+                        color = 9; glyph = 'o';
+                    } else {
+                        color = 4; glyph = 'O';
+                    }
+                    break;
+                case Cell::GROWTH:      color = 5; glyph = '+'; break;
+                case Cell::POISON:      color = 6; glyph = '-'; break;
+                case Cell::TIME:        color = 8; glyph = 'T'; break;
+                default: break;
+            }
+            if (color != 0) {
+                mvwaddch(board, row + 1, col + 1, glyph | COLOR_PAIR(color));
+            }
+        }
+    }
+
+    // 칸 단위로만 그릴 수 있으므로, 다음 칸까지 절반 이상 왔으면 그 칸에 머리 색 점을 찍어 진행을 보여줌
+    if (alpha >= 0.5 && frame.headDirection >= 1 && frame.headDirection <= 4) {
+        Coord ahead = frame.head;
+        switch (frame.headDirection) {
+            case 1: ahead.row--; break;
+            case 2: ahead.col--; break;
+            case 3: ahead.col++; break;
+            case 4: ahead.row++; break;
+        }
+        if (frame.visible(ahead) &&
+            frame.at(ahead.row - frame.originRow, ahead.col - frame.originCol) == Cell::EMPTY) {
+            mvwaddch(board, ahead.row - frame.originRow + 1, ahead.col - frame.originCol + 1, '.' | COLOR_PAIR(3));
+        }
+    }
+}
+
+void Renderer::drawScore(WINDOW* score, const FrameSnapshot& frame)
+{
+    mvwprintw(score, 1, 1, "*******Score Board*******");
+    mvwprintw(score, 2, 1, " Stage: %d/4", frame.stage);
+    mvwprintw(score, 3, 1, " B: %d/%d", frame.bodySize, frame.maxSnakeLength);
+    mvwprintw(score, 4, 1, " +: %d", frame.growthCount);
+    mvwprintw(score, 5, 1, " -: %d", frame.poisonCount);
+    mvwprintw(score, 6, 1, " G: %d", frame.gateCount);
+    mvwprintw(score, 7, 1, " time: %d", frame.elapsedSeconds);
+}
+
+void Renderer::drawMission(WINDOW* mission, const FrameSnapshot& frame)
+{
+    mvwprintw(mission, 1, 1, "******Mission Board******");
+    mvwprintw(mission, 2, 1, " Stage %d: %s", frame.stage,
+        frame.stage == 1 ? "BASIC" :
+        frame.stage == 2 ? "MAZE" :
+        frame.stage == 3 ? "ISLANDS" : "CROSS");
+    int lines = std::min(frame.missionCount, FrameSnapshot::MAX_MISSION_LINES);
+    // 다 못 보여주면 마지막 줄은 요약으로 사용
+    if (frame.missionCount > FrameSnapshot::MAX_MISSION_LINES) lines--;
+    for (int i = 0; i < lines; ++i) {
+        const FrameSnapshot::MissionLine& line = frame.missions[i];
+        mvwprintw(mission, 3 + i, 1, " %c: %d / %d (%c) ", line.symbol, line.target, line.current,
+                  line.achieved ? 'v' : ' ');
+    }
+    if (lines < frame.missionCount) {
+        mvwprintw(mission, 3 + lines, 1, " ... %d more (%d/%d done)", frame.missionCount - lines,
+                  frame.missionsAchieved, frame.missionCount);
+    }
+}
+
+void Renderer::drawMinimap(WINDOW* minimap, const FrameSnapshot& frame)
+{
+    mvwprintw(minimap, 0, 2, " Map 1:%d ", frame.minimapBlock);
+    // 보드에 보이는 영역은 빈 블록도 점으로 표시
+    for (int row = 0; row < frame.minimapRows; ++row) {
+        for (int col = 0; col < frame.minimapCols; ++col) {
+            chtype glyph = ' ';
+            switch (frame.minimap[row][col]) {
+                case MinimapGlyph::HEAD:      glyph = '@' | A_BOLD | COLOR_PAIR(3); break;
+                case MinimapGlyph::BODY:      glyph = 'o' | COLOR_PAIR(4); break;
+                case MinimapGlyph::WALL:      glyph = ACS_BLOCK; break;
+                case MinimapGlyph::SOME_WALL: glyph = ACS_CKBOARD; break;
+                case MinimapGlyph::ITEM:      glyph = '+' | COLOR_PAIR(3); break;
+                case MinimapGlyph::EMPTY:
+                    if (frame.minimapInView(row, col)) glyph = '.';
+                    break;
+            }
+            mvwaddch(minimap, 1 + row, 1 + col, glyph);
+        }
+    }
+}
+
+#endif
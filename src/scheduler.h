@@ -0,0 +1,166 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// 고정 주기 시뮬레이션 + 개체별 속도 누산기
+// - 실제 경과 시간을 고정 스텝(1/simHz초)으로 쪼개 진행 (sleep 오차가 쌓이지 않음)
+// - 개체마다 "초당 칸 수" 속도를 가지며, 스텝마다 속도만큼 진행도를 쌓다가 한 칸 분량이 차면 이동
+//   → 정수 누산이라 1.5배 같은 속도도 오차 없이 평균 간격이 맞음
+// - 속도 변경은 다음 스텝부터 바로 반영 (진행 중인 칸의 진행도는 유지)
+// - 화면은 시뮬레이션과 별개로 그리며, lastMoveTime/movePeriod로 칸 사이 진행 비율을 구해 보간
+class AccumulatorScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using EntityId = size_t;
+
+    static constexpr int MIN_SIM_HZ = 1;
+    static constexpr int MAX_SIM_HZ = 10000;
+    // 한 번에 따라잡는 최대 스텝 (디버거 정지·시스템 sleep 뒤 몰아치기 방지)
+    static constexpr int MAX_CATCH_UP_MS = 250;
+
+    explicit AccumulatorScheduler(int simHz = 1000);
+
+    int simHz() const { return hz; }
+    Clock::duration stepDuration() const { return step; }
+
+    EntityId addEntity(double cellsPerSecond);
+    void setSpeed(EntityId entity, double cellsPerSecond);
+
+    // 기준 시각 재설정 (시작 시, 모달 화면에서 돌아온 뒤). 진행도는 유지
+    void resync(Clock::time_point now);
+    // now까지 밀린 스텝을 진행하다가 어떤 개체가 한 칸 이동할 차례가 되면 true (entity에 기록)
+    // 같은 스텝에 여러 개체가 이동하면 호출마다 하나씩 돌려줌
+    bool nextMove(Clock::time_point now, EntityId& entity);
+    // 가장 먼저 이동할 개체의 이동 시각 (대기할 시각)
+    Clock::time_point nextMoveTime() const;
+
+    // 마지막 이동 시각과 현재 속도 기준 한 칸 이동 간격 (렌더러 보간용)
+    Clock::time_point lastMoveTime(EntityId entity) const { return entities.at(entity).lastMove; }
+    Clock::duration movePeriod(EntityId entity) const;
+
+private:
+    // 진행도는 "스텝 x 밀리칸/초" 단위: 한 칸 = hz * 1000
+    struct Entity
+    {
+        uint64_t speed = 0;         // 밀리칸/초
+        uint64_t progress = 0;
+        Clock::time_point lastMove;
+        bool due = false;           // 이번 스텝에 이동했지만 아직 nextMove()로 돌려주지 않음
+    };
+
+    int hz;
+    Clock::duration step;
+    uint64_t cellThreshold;
+    Clock::time_point stepTime;     // 마지막으로 진행한 스텝의 시각
+    std::vector<Entity> entities;
+    size_t dueCount = 0;
+
+    static uint64_t toMilliCells(double cellsPerSecond);
+    void runStep();
+};
+
+AccumulatorScheduler::AccumulatorScheduler(int simHz)
+{
+    if (simHz < MIN_SIM_HZ || simHz > MAX_SIM_HZ) {
+        throw std::invalid_argument("Simulation rate out of range");
+    }
+    hz = simHz;
+    step = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(1000000000LL / simHz));
+    cellThreshold = (uint64_t)simHz * 1000;
+    stepTime = Clock::now();
+}
+
+uint64_t AccumulatorScheduler::toMilliCells(double cellsPerSecond)
+{
+    return cellsPerSecond > 0 ? (uint64_t)(cellsPerSecond * 1000 + 0.5) : 0;
+}
+
+AccumulatorScheduler::EntityId AccumulatorScheduler::addEntity(double cellsPerSecond)
+{
+    Entity entity;
+    entity.speed = toMilliCells(cellsPerSecond);
+    entity.lastMove = stepTime;
+    entities.push_back(entity);
+    return entities.size() - 1;
+}
+
+void AccumulatorScheduler::setSpeed(EntityId entity, double cellsPerSecond)
+{
+    entities.at(entity).speed = toMilliCells(cellsPerSecond);
+}
+
+void AccumulatorScheduler::resync(Clock::time_point now)
+{
+    stepTime = now;
+    for (Entity& entity : entities) {
+        // 멈춰 있던 시간만큼 이동 시각도 미룸 (보간이 튀지 않게)
+        entity.lastMove = now - std::chrono::duration_cast<Clock::duration>(
+            step * (entity.speed ? entity.progress / entity.speed : 0));
+    }
+}
+
+void AccumulatorScheduler::runStep()
+{
+    stepTime += step;
+    for (Entity& entity : entities) {
+        entity.progress += entity.speed;
+        if (entity.progress >= cellThreshold) {
+            // 한 스텝에 두 칸 이상은 가지 않음 (초당 칸 수가 simHz를 넘으면 simHz로 제한)
+            entity.progress = std::min(entity.progress - cellThreshold, cellThreshold - 1);
+            entity.lastMove = stepTime;
+            entity.due = true;
+            dueCount++;
+        }
+    }
+}
+
+bool AccumulatorScheduler::nextMove(Clock::time_point now, EntityId& entity)
+{
+    if (now - stepTime > std::chrono::milliseconds(MAX_CATCH_UP_MS)) {
+        stepTime = now - std::chrono::milliseconds(MAX_CATCH_UP_MS);
+    }
+    while (dueCount == 0 && stepTime + step <= now) {
+        runStep();
+    }
+    if (dueCount == 0) return false;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (entities[i].due) {
+            entities[i].due = false;
+            dueCount--;
+            entity = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+AccumulatorScheduler::Clock::time_point AccumulatorScheduler::nextMoveTime() const
+{
+    if (dueCount > 0) return stepTime;
+    // 움직이는 개체가 없으면 1초 뒤
+    uint64_t fewestSteps = (uint64_t)hz;
+    for (const Entity& entity : entities) {
+        if (entity.speed == 0) continue;
+        uint64_t remaining = cellThreshold - entity.progress;
+        fewestSteps = std::min(fewestSteps, (remaining + entity.speed - 1) / entity.speed);
+    }
+    return stepTime + step * fewestSteps;
+}
+
+AccumulatorScheduler::Clock::duration AccumulatorScheduler::movePeriod(EntityId entity) const
+{
+    uint64_t speed = entities.at(entity).speed;
+    if (speed == 0) return Clock::duration::zero();
+    return step * ((cellThreshold + speed - 1) / speed);
+}
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "grid.h"
+#include "minimap.h"
+
+using namespace std;
+
+// 한 틱이 끝난 시점의 화면 상태 (렌더 스레드가 읽는 불변 사본)
+// 시뮬레이션 쪽 자료구조를 전혀 참조하지 않으므로 그리는 동안 다음 틱이 진행되어도 안전
+struct FrameSnapshot
+{
+    uint64_t tick = 0;
+    // 보드 화면에 보이는 영역만 복사 (맵 크기와 무관하게 화면 크기만큼)
+    int rows = 0, cols = 0;
+    int originRow = 1, originCol = 1;   // cells[0]의 점유 격자 좌표
+    std::vector<Cell> cells;        // 보이는 영역의 점유 격자 사본 (rows x cols)
+    Coord head{0, 0};               // 머리·꼬리는 점유 격자 좌표
+    Coord tail{0, 0};
+    int headDirection = -1;
+
+    int stage = 1;
+    int bodySize = 0;
+    int maxSnakeLength = 0;
+    int growthCount = 0;
+    int poisonCount = 0;
+    int gateCount = 0;
+    int elapsedSeconds = 0;
+    // 미션 보드에 보이는 줄 (앞에서부터 MAX_MISSION_LINES개)
+    static constexpr int MAX_MISSION_LINES = 5;
+    struct MissionLine
+    {
+        char symbol;
+        int target;
+        int current;
+        bool achieved;
+    };
+    MissionLine missions[MAX_MISSION_LINES];
+    int missionCount = 0;           // 전체 미션 수 (줄 수보다 많을 수 있음)
+    int missionsAchieved = 0;
+    uint32_t soundCues = 0;         // 효과음 사건 누적 수 (이전 프레임보다 늘었으면 beep)
+    // 미니맵 (minimapRows가 0이면 없음). 글리프 하나 = minimapBlock x minimapBlock칸
+    static constexpr int MAX_MINIMAP_ROWS = 17;
+    static constexpr int MAX_MINIMAP_COLS = 25;
+    int minimapRows = 0, minimapCols = 0;
+    int minimapBlock = 0;
+    MinimapGlyph minimap[MAX_MINIMAP_ROWS][MAX_MINIMAP_COLS];
+    // 머리가 마지막으로 칸을 옮긴 시각과 현재 속도의 한 칸 간격 (간격이 0이면 보간하지 않음)
+    std::chrono::steady_clock::time_point moveStart;
+    std::chrono::steady_clock::duration movePeriod{0};
+
+    // 보이는 영역 기준 좌표 (0 ~ rows-1, 0 ~ cols-1)
+    Cell at(int row, int col) const { return cells[(size_t)row * cols + col]; }
+    bool visible(const Coord& pos) const
+    {
+        return pos.row >= originRow && pos.row < originRow + rows && pos.col >= originCol && pos.col < originCol + cols;
+    }
+    // 미니맵 글리프 (row, col)이 보드에 보이는 영역과 겹치는지
+    bool minimapInView(int row, int col) const
+    {
+        int top = row * minimapBlock, left = col * minimapBlock;
+        return top + minimapBlock > originRow && top < originRow + rows &&
+               left + minimapBlock > originCol && left < originCol + cols;
+    }
+
+    // now 시점에 머리가 다음 칸까지 간 비율 (0~1)
+    double moveAlpha(std::chrono::steady_clock::time_point now) const
+    {
+        if (movePeriod <= std::chrono::steady_clock::duration::zero()) return 0;
+        double alpha = std::chrono::duration<double>(now - moveStart) / std::chrono::duration<double>(movePeriod);
+        return alpha < 0 ? 0 : (alpha > 1 ? 1 : alpha);
+    }
+
+    // 점유 격자의 (top, left)부터 viewRows x viewCols 영역을 복사 (크기가 같으면 재할당 없이 덮어씀)
+    void copyRegion(const OccupancyGrid& grid, int top, int left, int viewRows, int viewCols)
+    {
+        rows = viewRows;
+        cols = viewCols;
+        originRow = top;
+        originCol = left;
+        cells.resize((size_t)rows * cols);
+        const Cell* source = grid.data() + (size_t)top * grid.cols() + left;
+        for (int row = 0; row < rows; ++row) {
+            std::copy(source, source + cols, cells.begin() + (size_t)row * cols);
+            source += grid.cols();
+        }
+    }
+};
+
+// 단일 생산자 / 단일 소비자 triple buffer
+// - 생산자는 writeBuffer()를 채운 뒤 publish(), 소비자는 update()로 최신 것을 가져와 readBuffer()를 읽음
+// - 양쪽 모두 대기하지 않음: 소비자가 느리면 중간 프레임은 덮어써져 버려짐
+// - 세 슬롯은 생성 시 한 번만 만들어지고 이후 교환만 일어남 (프레임마다 할당 없음)
+template <typename T>
+class TripleBuffer
+{
+public:
+    explicit TripleBuffer(const T& initial = T()) : slots{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // 생산자 전용
+    T& writeBuffer() { return slots[backIndex]; }
+    void publish()
+    {
+        uint8_t previous = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    // 소비자 전용: 새 프레임이 있으면 true
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = previous & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return slots[frontIndex]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;      // 중간 슬롯이 아직 소비되지 않은 프레임
+
+    T slots[3];
+    uint8_t backIndex = 0;                  // 생산자 전용
+    alignas(64) std::atomic<uint8_t> middle{1};
+    alignas(64) uint8_t frontIndex = 2;     // 소비자 전용
+};
+
+#endif
@@ -0,0 +1,189 @@
+// 아이템 스폰 위치 선택 지연 벤치마크
+// 판을 채운 비율별로 스폰 위치 선택 지연 분포(p50/p99/p99.9/최대)를 잰다
+// - freecells : 빈 칸 목록에서 고르는 현재 방식 (pickSpawnCell)
+// - rejection : 맵 전체에서 무작위 좌표를 맞을 때까지 뽑던 이전 방식 (비교용, 놓을 칸이 없으면 끝나지 않으므로 건너뜀)
+//
+//   g++ -std=c++17 -O2 src/spawn_bench.cpp -o spawn_bench
+//   ./spawn_bench --picks 200000 --seed 1 --size 21x41
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "map.h"
+#include "reachability.h"
+#include "freecells.h"
+
+struct BenchConfig
+{
+    size_t picks = 200000;      // --picks : 채움 비율마다 고르는 횟수
+    unsigned seed = 1;          // --seed
+    int height = 21;            // --size HxW
+    int width = 41;
+};
+
+// 판 하나: 빈 칸을 무작위 순서로 몸통 칸으로 바꿔 원하는 비율만큼 채움
+struct FilledBoard
+{
+    Map map;
+    ReachabilityMap freeSpace;
+    FreeCellSet freeCells;
+    Coord head{0, 0};
+    size_t openCells = 0;       // 채우기 전 빈 칸 수
+
+    FilledBoard(const BenchConfig& config, double fill, std::mt19937& rng);
+};
+
+FilledBoard::FilledBoard(const BenchConfig& config, double fill, std::mt19937& rng)
+    : map(config.height, config.width)
+{
+    OccupancyGrid& grid = map.occupancy;
+    std::vector<Coord> open;
+    for (int row = 0; row < grid.rows(); ++row) {
+        for (int col = 0; col < grid.cols(); ++col) {
+            if (grid.at(Coord{row, col}) == Cell::EMPTY) open.push_back(Coord{row, col});
+        }
+    }
+    openCells = open.size();
+    std::shuffle(open.begin(), open.end(), rng);
+    size_t filled = std::min(open.size(), (size_t)(fill * open.size() + 0.5));
+    for (size_t i = 0; i < filled; ++i) grid.enterSnake(open[i], Cell::BODY);
+    // 머리는 처음 채운 칸 (채운 칸이 없으면 맵 안 아무 칸)
+    head = filled > 0 ? open[0] : Coord{2, 2};
+    freeSpace.rebuild(grid);
+    freeCells.rebuild(grid);
+}
+
+// 이전 방식: 맵 안 무작위 좌표를 조건에 맞을 때까지 뽑음 (닿는 요소 조건은 4 x 칸 수 번 뒤 포기)
+void rejectionPick(const FilledBoard& board, const ReachabilityMap::ReachableSet& reachable, Coord& out)
+{
+    const OccupancyGrid& grid = board.map.occupancy;
+    const MapDimensions& size = board.map.mapSize;
+    long attemptsLeft = reachable.count > 0 ? 4L * size.height * size.width : 0;
+    while (true) {
+        int row = rand() % (size.height - 1) + 2;
+        int col = rand() % (size.width - 1) + 2;
+        Cell cell = grid.at(Coord{row, col});
+        int dr[4] = {-1, 1, 0, 0};
+        int dc[4] = {0, 0, -1, 1};
+        int wallCount = 0;
+        for (int d = 0; d < 4; ++d) {
+            Cell adj = grid.at(Coord{row + dr[d], col + dc[d]});
+            if (adj == Cell::WALL || adj == Cell::GATE) wallCount++;
+        }
+        bool unreachable = attemptsLeft > 0 && cell == Cell::EMPTY &&
+                           !reachable.contains(board.freeSpace.label(Coord{row, col}));
+        if (attemptsLeft > 0) attemptsLeft--;
+        if (cell == Cell::EMPTY && wallCount < 4 && !unreachable) {
+            out = Coord{row, col};
+            return;
+        }
+    }
+}
+
+struct LatencySummary
+{
+    double p50 = 0, p99 = 0, p999 = 0, max = 0;     // 마이크로초
+};
+
+LatencySummary summarize(std::vector<double>& samples)
+{
+    LatencySummary summary;
+    if (samples.empty()) return summary;
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[std::min(samples.size() - 1, (size_t)(q * samples.size()))]; };
+    summary.p50 = at(0.50);
+    summary.p99 = at(0.99);
+    summary.p999 = at(0.999);
+    summary.max = samples.back();
+    return summary;
+}
+
+template <typename Pick>
+LatencySummary measure(size_t picks, Pick pick)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> samples;
+    samples.reserve(picks);
+    for (size_t i = 0; i < picks; ++i) {
+        Clock::time_point start = Clock::now();
+        pick();
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    return summarize(samples);
+}
+
+void printRow(const char* method, double fill, size_t freeCount, const LatencySummary& s)
+{
+    std::printf("%-10s %6.1f%% %7zu %10.3f %10.3f %10.3f %10.3f\n",
+                method, fill * 100, freeCount, s.p50, s.p99, s.p999, s.max);
+}
+
+int runBench(const BenchConfig& config)
+{
+    const double fills[] = {0.0, 0.5, 0.75, 0.9, 0.95, 0.98, 0.99, 0.995, 1.0};
+    std::mt19937 rng(config.seed);
+    srand(config.seed);
+    std::printf("%-10s %7s %7s %10s %10s %10s %10s   (us)\n", "method", "fill", "free", "p50", "p99", "p99.9", "max");
+    for (double fill : fills) {
+        FilledBoard board(config, fill, rng);
+        ReachabilityMap::ReachableSet reachable = board.freeSpace.reachableFrom(board.head, board.map.gameGates);
+        size_t misses = 0;
+        Coord out;
+        LatencySummary current = measure(config.picks, [&] {
+            if (!pickSpawnCell(board.map.occupancy, board.freeCells, board.freeSpace, reachable, rng, out)) misses++;
+        });
+        printRow("freecells", fill, board.freeCells.size(), current);
+        if (misses == config.picks) {
+            std::printf("%-10s %6.1f%% %7zu  (no valid cell: every pick returned false)\n", "", fill * 100, board.freeCells.size());
+        }
+        // 이전 방식은 놓을 칸이 없으면 끝나지 않음
+        if (misses == 0) {
+            LatencySummary legacy = measure(config.picks, [&] { rejectionPick(board, reachable, out); });
+            printRow("rejection", fill, board.freeCells.size(), legacy);
+        }
+    }
+    return 0;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--picks N] [--seed N] [--size HxW]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    BenchConfig config;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(arg, "--picks") == 0 && hasValue) {
+            config.picks = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            config.seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &config.height, &config.width) != 2) {
+                printUsage(argv[0]);
+                return 2;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (config.picks == 0 || config.height < 10 || config.width < 10) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    try {
+        return runBench(config);
+    } catch (const std::exception& e) {
+        std::cerr << "Spawn bench error: " << e.what() << std::endl;
+        return 1;
+    }
+}
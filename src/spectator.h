@@ -0,0 +1,554 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "events.h"
+#include "grid.h"
+#include "spsc.h"
+
+using namespace std;
+
+// 관전 프로토콜 (리틀 엔디언)
+//   메시지  = u32 길이(이후 바이트 수) | u8 종류 | 내용
+//   SNAPSHOT: u32 틱 | u16 행 | u16 열 | 행×열 바이트 (Cell 값)
+//   TICK    : u32 틱 | u16 개수 | 개수 × { u8 델타 종류 | u8 Cell | u16 행 | u16 열 }
+// 델타의 Cell은 그 칸이 이번 틱 이후 보여야 하는 값이므로 순서대로 덮어쓰면 화면이 복원됨
+enum SpectatorMessage : uint8_t {
+    SPECTATOR_SNAPSHOT = 1,
+    SPECTATOR_TICK = 2
+};
+
+enum class DeltaKind : uint8_t {
+    HEAD_MOVE = 1,
+    TAIL_VACATE = 2,
+    ITEM_SPAWN = 3,
+    GATE_ACTIVATE = 4,
+    CELL_CHANGE = 5
+};
+
+namespace spectator_wire {
+    inline uint8_t* putU16(uint8_t* p, uint16_t v) { p[0] = v & 0xff; p[1] = v >> 8; return p + 2; }
+    inline uint8_t* putU32(uint8_t* p, uint32_t v) { for (int i = 0; i < 4; ++i) p[i] = (v >> (8 * i)) & 0xff; return p + 4; }
+    inline uint16_t getU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    inline uint32_t getU32(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+    const size_t DELTA_BYTES = 6;
+    const size_t HEADER_BYTES = 5;
+}
+
+// 틱 스레드가 델타를 발행하고, 별도 서버 스레드가 epoll로 여러 관전자에게 나눠 보냄
+// 틱 스레드 쪽 비용은 링 버퍼 memcpy + eventfd write 한 번 (소켓 I/O는 전부 서버 스레드)
+class SpectatorServer : public GameEventSink
+{
+public:
+    SpectatorServer() = default;
+    ~SpectatorServer();
+
+    SpectatorServer(const SpectatorServer&) = delete;
+    SpectatorServer& operator=(const SpectatorServer&) = delete;
+
+    // Unix 도메인 소켓을 열고 서버 스레드 시작 (실패 시 runtime_error)
+    void start(const std::string& socketPath);
+    void stop();
+
+    // --- 틱 스레드 전용 ---
+    void record(DeltaKind kind, const Coord& pos, Cell cell);
+    // 게임 사건 중 칸이 바뀌는 것만 델타로 기록
+    void onEvent(const GameEvent& event) override;
+    // 다음 endTick에서 델타 대신 전체 격자를 보냄 (스테이지 리셋 등)
+    void requestSnapshot() { snapshotRequested = true; }
+    // 이번 틱의 델타를 한 메시지로 묶어 발행
+    void endTick(const OccupancyGrid& grid);
+
+    size_t clientCount() const { return connectedClients.load(std::memory_order_relaxed); }
+
+private:
+    static const size_t MAX_DELTAS_PER_TICK = 256;
+    static const size_t MAX_CLIENT_BACKLOG = 4 * 1024 * 1024;   // 넘으면 느린 관전자로 보고 연결 종료
+
+    // 클라이언트 슬롯은 연결이 끊겨도 자리를 유지하고(fd = -1) 다음 연결이 재사용
+    // epoll 이벤트에는 슬롯 번호와 fd를 실어 두어 찾는 비용이 O(1)
+    // (같은 epoll_wait 묶음 안에서 슬롯이 재사용되면 fd가 달라 옛 이벤트는 무시됨)
+    struct Client
+    {
+        int fd = -1;
+        std::vector<uint8_t> out;
+        size_t sent = 0;
+        bool waitingWritable = false;
+    };
+    static constexpr uint64_t LISTEN_TOKEN = UINT64_MAX;
+    static constexpr uint64_t WAKE_TOKEN = UINT64_MAX - 1;
+    static uint64_t clientToken(size_t slot, int fd) { return ((uint64_t)(uint32_t)fd << 32) | (uint32_t)slot; }
+
+    // 생산자(틱 스레드) 상태
+    uint8_t pendingDeltas[MAX_DELTAS_PER_TICK * spectator_wire::DELTA_BYTES];
+    size_t pendingCount = 0;
+    bool snapshotRequested = true;
+    uint32_t tickNumber = 0;
+    std::vector<uint8_t> message;
+
+    // 스레드 간 공유
+    SpscRing<uint8_t, (1 << 20)> ring;
+    std::atomic<bool> running{false};
+    std::atomic<size_t> connectedClients{0};
+    std::thread worker;
+    int listenFd = -1;
+    int epollFd = -1;
+    int wakeFd = -1;
+    std::string path;
+
+    // 소비자(서버 스레드) 상태
+    std::vector<Client> clients;
+    std::vector<size_t> freeSlots;
+    std::vector<uint8_t> stream;
+    uint16_t gridRows = 0, gridCols = 0;
+    uint32_t gridTick = 0;
+    std::vector<uint8_t> gridCells;
+
+    void run();
+    void acceptClients();
+    void dropClient(size_t slot);
+    void handleClientEvent(uint64_t token, uint32_t events);
+    void drainRing();
+    void applyMessage(const uint8_t* msg, size_t length);
+    void broadcast(const uint8_t* msg, size_t length);
+    void appendSnapshot(Client& client);
+    bool flushClient(Client& client);
+    void watchWritable(Client& client, bool enable);
+};
+
+SpectatorServer::~SpectatorServer()
+{
+    stop();
+}
+
+void SpectatorServer::start(const std::string& socketPath)
+{
+    if (running.load()) return;
+    path = socketPath;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("Spectator socket path too long: " + path);
+    }
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error(std::string("Failed to create spectator socket: ") + std::strerror(errno));
+    }
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(listenFd, 64) < 0) {
+        int err = errno;
+        close(listenFd);
+        listenFd = -1;
+        throw std::runtime_error("Failed to listen on " + path + ": " + std::strerror(err));
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        int err = errno;
+        stop();
+        throw std::runtime_error(std::string("Failed to set up spectator epoll: ") + std::strerror(err));
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = LISTEN_TOKEN;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.u64 = WAKE_TOKEN;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev);
+
+    running = true;
+    worker = std::thread(&SpectatorServer::run, this);
+}
+
+void SpectatorServer::stop()
+{
+    if (running.exchange(false)) {
+        uint64_t one = 1;
+        ssize_t ignored = write(wakeFd, &one, sizeof(one));
+        (void)ignored;
+        worker.join();
+    }
+    for (auto& client : clients) {
+        if (client.fd >= 0) close(client.fd);
+    }
+    clients.clear();
+    freeSlots.clear();
+    connectedClients = 0;
+    if (listenFd >= 0) { close(listenFd); unlink(path.c_str()); listenFd = -1; }
+    if (epollFd >= 0) { close(epollFd); epollFd = -1; }
+    if (wakeFd >= 0) { close(wakeFd); wakeFd = -1; }
+}
+
+void SpectatorServer::record(DeltaKind kind, const Coord& pos, Cell cell)
+{
+    if (pendingCount == MAX_DELTAS_PER_TICK) {
+        // 한 틱에 델타가 너무 많으면 전체 격자로 대체
+        snapshotRequested = true;
+        return;
+    }
+    uint8_t* p = pendingDeltas + pendingCount * spectator_wire::DELTA_BYTES;
+    p[0] = static_cast<uint8_t>(kind);
+    p[1] = static_cast<uint8_t>(cell);
+    p = spectator_wire::putU16(p + 2, static_cast<uint16_t>(pos.row));
+    spectator_wire::putU16(p, static_cast<uint16_t>(pos.col));
+    pendingCount++;
+}
+
+void SpectatorServer::onEvent(const GameEvent& event)
+{
+    switch (event.type) {
+        case EventType::HEAD_MOVED:   record(DeltaKind::HEAD_MOVE, event.pos, event.cell); break;
+        case EventType::TAIL_VACATED: record(DeltaKind::TAIL_VACATE, event.pos, event.cell); break;
+        case EventType::ITEM_SPAWNED: record(DeltaKind::ITEM_SPAWN, event.pos, event.cell); break;
+        case EventType::GATE_ENTERED: record(DeltaKind::GATE_ACTIVATE, event.pos, event.cell); break;
+        case EventType::CELL_CHANGED: record(DeltaKind::CELL_CHANGE, event.pos, event.cell); break;
+        default: break;
+    }
+}
+
+void SpectatorServer::endTick(const OccupancyGrid& grid)
+{
+    using namespace spectator_wire;
+    tickNumber++;
+    if (!running.load(std::memory_order_relaxed)) {
+        pendingCount = 0;
+        return;
+    }
+
+    size_t payload;
+    if (snapshotRequested) {
+        size_t cellCount = (size_t)grid.rows() * grid.cols();
+        payload = 1 + 4 + 2 + 2 + cellCount;
+        if (message.size() < 4 + payload) message.resize(4 + payload);
+        uint8_t* p = putU32(message.data(), static_cast<uint32_t>(payload));
+        *p++ = SPECTATOR_SNAPSHOT;
+        p = putU32(p, tickNumber);
+        p = putU16(p, static_cast<uint16_t>(grid.rows()));
+        p = putU16(p, static_cast<uint16_t>(grid.cols()));
+        std::memcpy(p, grid.data(), cellCount);
+    } else {
+        payload = 1 + 4 + 2 + pendingCount * DELTA_BYTES;
+        if (message.size() < 4 + payload) message.resize(4 + payload);
+        uint8_t* p = putU32(message.data(), static_cast<uint32_t>(payload));
+        *p++ = SPECTATOR_TICK;
+        p = putU32(p, tickNumber);
+        p = putU16(p, static_cast<uint16_t>(pendingCount));
+        std::memcpy(p, pendingDeltas, pendingCount * DELTA_BYTES);
+    }
+    pendingCount = 0;
+
+    // 서버 스레드가 밀려 링이 가득 차면 이번 틱은 버리고 다음 틱에 전체 격자로 재동기화
+    snapshotRequested = !ring.pushBulk(message.data(), 4 + payload);
+
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void SpectatorServer::run()
+{
+    epoll_event events[64];
+    while (running.load()) {
+        int n = epoll_wait(epollFd, events, 64, 100);
+        for (int i = 0; i < n; ++i) {
+            uint64_t token = events[i].data.u64;
+            if (token == LISTEN_TOKEN) {
+                acceptClients();
+            } else if (token == WAKE_TOKEN) {
+                uint64_t count;
+                ssize_t ignored = read(wakeFd, &count, sizeof(count));
+                (void)ignored;
+            } else {
+                handleClientEvent(token, events[i].events);
+            }
+        }
+        drainRing();
+    }
+}
+
+void SpectatorServer::acceptClients()
+{
+    while (true) {
+        int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) return;
+
+        size_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = clients.size();
+            clients.emplace_back();
+        }
+        Client& client = clients[slot];
+        client.fd = fd;
+        client.sent = 0;
+        client.waitingWritable = false;
+
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u64 = clientToken(slot, fd);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        connectedClients = clients.size() - freeSlots.size();
+        // 새 관전자는 서버가 델타로 유지하는 격자 전체부터 받음
+        if (!gridCells.empty()) {
+            appendSnapshot(client);
+            if (!flushClient(client)) dropClient(slot);
+        }
+    }
+}
+
+void SpectatorServer::dropClient(size_t slot)
+{
+    Client& client = clients[slot];
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+    close(client.fd);
+    client.fd = -1;
+    client.out.clear();
+    client.sent = 0;
+    freeSlots.push_back(slot);
+    connectedClients = clients.size() - freeSlots.size();
+}
+
+void SpectatorServer::handleClientEvent(uint64_t token, uint32_t events)
+{
+    size_t slot = (uint32_t)token;
+    int fd = (int)(token >> 32);
+    if (slot >= clients.size() || clients[slot].fd != fd) return;
+    if (events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+        dropClient(slot);
+        return;
+    }
+    if (events & EPOLLIN) {
+        // 관전자가 보내는 데이터는 무시 (연결 종료 감지용)
+        uint8_t discard[256];
+        ssize_t r = recv(fd, discard, sizeof(discard), MSG_DONTWAIT);
+        if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            dropClient(slot);
+            return;
+        }
+    }
+    if ((events & EPOLLOUT) && !flushClient(clients[slot])) {
+        dropClient(slot);
+    }
+}
+
+void SpectatorServer::drainRing()
+{
+    uint8_t chunk[64 * 1024];
+    size_t n;
+    while ((n = ring.popBulk(chunk, sizeof(chunk))) > 0) {
+        stream.insert(stream.end(), chunk, chunk + n);
+    }
+
+    size_t offset = 0;
+    while (stream.size() - offset >= 4) {
+        uint32_t length = spectator_wire::getU32(&stream[offset]);
+        if (stream.size() - offset < 4 + length) break;
+        applyMessage(&stream[offset], 4 + length);
+        offset += 4 + length;
+    }
+    stream.erase(stream.begin(), stream.begin() + offset);
+
+    for (size_t slot = 0; slot < clients.size(); ++slot) {
+        Client& client = clients[slot];
+        if (client.fd < 0) continue;
+        if (client.out.size() - client.sent > MAX_CLIENT_BACKLOG || !flushClient(client)) {
+            dropClient(slot);
+        }
+    }
+}
+
+void SpectatorServer::applyMessage(const uint8_t* msg, size_t length)
+{
+    using namespace spectator_wire;
+    uint8_t type = msg[4];
+    if (type == SPECTATOR_SNAPSHOT) {
+        gridTick = getU32(msg + 5);
+        gridRows = getU16(msg + 9);
+        gridCols = getU16(msg + 11);
+        gridCells.assign(msg + 13, msg + length);
+    } else if (type == SPECTATOR_TICK && !gridCells.empty()) {
+        gridTick = getU32(msg + 5);
+        uint16_t count = getU16(msg + 9);
+        const uint8_t* p = msg + 11;
+        for (uint16_t i = 0; i < count; ++i, p += DELTA_BYTES) {
+            uint16_t row = getU16(p + 2), col = getU16(p + 4);
+            if (row < gridRows && col < gridCols) {
+                gridCells[(size_t)row * gridCols + col] = p[1];
+            }
+        }
+    }
+    broadcast(msg, length);
+}
+
+void SpectatorServer::broadcast(const uint8_t* msg, size_t length)
+{
+    for (auto& client : clients) {
+        if (client.fd >= 0) client.out.insert(client.out.end(), msg, msg + length);
+    }
+}
+
+void SpectatorServer::appendSnapshot(Client& client)
+{
+    using namespace spectator_wire;
+    uint8_t header[HEADER_BYTES + 8];
+    uint8_t* p = putU32(header, static_cast<uint32_t>(1 + 4 + 2 + 2 + gridCells.size()));
+    *p++ = SPECTATOR_SNAPSHOT;
+    p = putU32(p, gridTick);
+    p = putU16(p, gridRows);
+    putU16(p, gridCols);
+    client.out.insert(client.out.end(), header, header + sizeof(header));
+    client.out.insert(client.out.end(), gridCells.begin(), gridCells.end());
+}
+
+bool SpectatorServer::flushClient(Client& client)
+{
+    while (client.sent < client.out.size()) {
+        ssize_t w = send(client.fd, client.out.data() + client.sent, client.out.size() - client.sent,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                watchWritable(client, true);
+                return true;
+            }
+            return false;
+        }
+        client.sent += static_cast<size_t>(w);
+    }
+    client.out.clear();
+    client.sent = 0;
+    watchWritable(client, false);
+    return true;
+}
+
+void SpectatorServer::watchWritable(Client& client, bool enable)
+{
+    if (client.waitingWritable == enable) return;
+    epoll_event ev{};
+    ev.events = EPOLLIN | EPOLLRDHUP | (enable ? (uint32_t)EPOLLOUT : 0u);
+    ev.data.u64 = clientToken(&client - clients.data(), client.fd);
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &ev);
+    client.waitingWritable = enable;
+}
+
+// 관전 클라이언트 쪽 디코더: 받은 바이트를 넣으면 격자를 복원
+// 소켓에서 온 바이트는 믿지 않음: 길이·크기·좌표가 맞지 않는 메시지가 오면 runtime_error (스트림 전체를 거부)
+class SpectatorDecoder
+{
+public:
+    // 완성된 메시지가 하나 이상 적용되었으면 true
+    bool feed(const uint8_t* data, size_t length);
+    const OccupancyGrid* grid() const { return board ? &*board : nullptr; }
+    uint32_t tick() const { return lastTick; }
+
+private:
+    static constexpr size_t SNAPSHOT_HEADER = 13;   // 길이 4 + 종류 1 + 틱 4 + 행 2 + 열 2
+    static constexpr size_t TICK_HEADER = 11;       // 길이 4 + 종류 1 + 틱 4 + 델타 수 2
+
+    std::vector<uint8_t> stream;
+    std::optional<OccupancyGrid> board;
+    uint32_t lastTick = 0;
+
+    // 메시지 머리(종류별 고정 부분)가 다 들어왔으면 길이가 종류·크기·델타 수와 맞는지 검사 (어긋나면 runtime_error)
+    // 머리가 아직 덜 왔으면 false
+    static bool checkHeader(const uint8_t* msg, size_t available);
+    static bool validCell(uint8_t value) { return value <= static_cast<uint8_t>(Cell::TIME); }
+};
+
+bool SpectatorDecoder::checkHeader(const uint8_t* msg, size_t available)
+{
+    using namespace spectator_wire;
+    uint32_t size = getU32(msg);
+    if (msg[4] == SPECTATOR_SNAPSHOT) {
+        if (available < SNAPSHOT_HEADER) return false;
+        int rows = getU16(msg + 9), cols = getU16(msg + 11);
+        // 테두리를 빼고 1x1 이상이어야 맵이 됨
+        if (rows < 3 || cols < 3 || size != SNAPSHOT_HEADER - 4 + (uint64_t)rows * cols) {
+            throw std::runtime_error("Malformed spectator snapshot (" + std::to_string(rows) + "x" + std::to_string(cols)
+                                     + ", " + std::to_string(size) + " bytes)");
+        }
+    } else if (msg[4] == SPECTATOR_TICK) {
+        if (available < TICK_HEADER) return false;
+        uint16_t count = getU16(msg + 9);
+        if (size != TICK_HEADER - 4 + (uint64_t)count * DELTA_BYTES) {
+            throw std::runtime_error("Malformed spectator tick (" + std::to_string(count) + " deltas, "
+                                     + std::to_string(size) + " bytes)");
+        }
+    } else {
+        throw std::runtime_error("Unknown spectator message type " + std::to_string(msg[4]));
+    }
+    return true;
+}
+
+bool SpectatorDecoder::feed(const uint8_t* data, size_t length)
+{
+    using namespace spectator_wire;
+    stream.insert(stream.end(), data, data + length);
+
+    bool updated = false;
+    size_t offset = 0;
+    while (stream.size() - offset >= HEADER_BYTES) {
+        const uint8_t* msg = &stream[offset];
+        size_t available = stream.size() - offset;
+        // 본문을 기다리기 전에 머리부터 검사 (엉터리 길이로 끝없이 쌓이지 않게)
+        if (!checkHeader(msg, available)) break;
+        uint32_t size = getU32(msg);
+        if (available < 4 + (size_t)size) break;
+
+        if (msg[4] == SPECTATOR_SNAPSHOT) {
+            int rows = getU16(msg + 9), cols = getU16(msg + 11);
+            const uint8_t* cells = msg + SNAPSHOT_HEADER;
+            for (size_t i = 0; i < (size_t)rows * cols; ++i) {
+                if (!validCell(cells[i])) throw std::runtime_error("Bad cell value in spectator snapshot");
+            }
+            lastTick = getU32(msg + 5);
+            board.emplace(rows - 2, cols - 2);
+            for (int i = 0; i < rows; ++i) {
+                for (int j = 0; j < cols; ++j) {
+                    board->setGround({i, j}, static_cast<Cell>(cells[(size_t)i * cols + j]));
+                }
+            }
+            updated = true;
+        } else if (board) {
+            // 델타는 서버의 applyMessage와 같은 기준으로 격자 안인지 확인하고, 하나라도 벗어나면 메시지째 거부
+            uint16_t count = getU16(msg + 9);
+            const uint8_t* deltas = msg + TICK_HEADER;
+            for (const uint8_t* p = deltas; p < deltas + (size_t)count * DELTA_BYTES; p += DELTA_BYTES) {
+                uint16_t row = getU16(p + 2), col = getU16(p + 4);
+                if (row >= board->rows() || col >= board->cols() || !validCell(p[1])) {
+                    throw std::runtime_error("Bad spectator delta (" + std::to_string(row) + ", " + std::to_string(col)
+                                             + ", cell " + std::to_string(p[1]) + ")");
+                }
+            }
+            lastTick = getU32(msg + 5);
+            for (const uint8_t* p = deltas; p < deltas + (size_t)count * DELTA_BYTES; p += DELTA_BYTES) {
+                board->setGround({getU16(p + 2), getU16(p + 4)}, static_cast<Cell>(p[1]));
+            }
+            updated = true;
+        }
+        offset += 4 + size;
+    }
+    stream.erase(stream.begin(), stream.begin() + offset);
+    return updated;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+// 단일 생산자 / 단일 소비자 lock-free 링 버퍼
+// - 생산자 스레드만 push*, 소비자 스레드만 pop*/peek* 를 호출해야 함
+// - Capacity는 2의 거듭제곱 (인덱스 마스킹)
+// - 가득 차면 push가 false를 반환하고 아무 것도 쓰지 않음 (생산자는 절대 대기하지 않음)
+template <typename T, size_t Capacity>
+class SpscRing
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing stores trivially copyable values");
+
+public:
+    bool push(const T& value)
+    {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - cachedHead == Capacity) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+            if (tail - cachedHead == Capacity) return false;
+        }
+        slots[tail & (Capacity - 1)] = value;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // count개를 한꺼번에 (전부 들어갈 공간이 없으면 하나도 쓰지 않음)
+    bool pushBulk(const T* values, size_t count)
+    {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (Capacity - (tail - cachedHead) < count) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+            if (Capacity - (tail - cachedHead) < count) return false;
+        }
+        size_t start = tail & (Capacity - 1);
+        size_t first = Capacity - start < count ? Capacity - start : count;
+        std::memcpy(&slots[start], values, first * sizeof(T));
+        std::memcpy(&slots[0], values + first, (count - first) * sizeof(T));
+        tailIndex.store(tail + count, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value)
+    {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+            if (head == cachedTail) return false;
+        }
+        value = slots[head & (Capacity - 1)];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 최대 maxCount개를 꺼냄, 꺼낸 개수 반환
+    size_t popBulk(T* values, size_t maxCount)
+    {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        cachedTail = tailIndex.load(std::memory_order_acquire);
+        size_t available = cachedTail - head;
+        size_t count = available < maxCount ? available : maxCount;
+        size_t start = head & (Capacity - 1);
+        size_t first = Capacity - start < count ? Capacity - start : count;
+        std::memcpy(values, &slots[start], first * sizeof(T));
+        std::memcpy(values + first, &slots[0], (count - first) * sizeof(T));
+        headIndex.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const
+    {
+        return headIndex.load(std::memory_order_acquire) == tailIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    // 생산자/소비자 인덱스를 서로 다른 캐시 라인에 두어 false sharing 방지
+    alignas(64) std::atomic<size_t> headIndex{0};
+    size_t cachedTail = 0;      // 소비자 전용
+    alignas(64) std::atomic<size_t> tailIndex{0};
+    size_t cachedHead = 0;      // 생산자 전용
+    alignas(64) T slots[Capacity];
+};
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include "events.h"
+
+using namespace std;
+
+// 한 판(스테이지 시도)이 끝난 방식
+enum class RunEnd : uint8_t {
+    DIED,           // Game Over (원인은 GAME_OVER 사건에서)
+    CLEARED,        // 미션 완료
+    ABANDONED       // 틱 상한을 넘겨 중단
+};
+
+// 여러 샤드를 합친 통계 (보고용 사본)
+struct StatsTotals
+{
+    static constexpr size_t DEATH_REASONS = static_cast<size_t>(DeathReason::TOO_SHORT) + 1;
+    static constexpr size_t ITEM_KINDS = static_cast<size_t>(ItemKind::TIME) + 1;
+    static constexpr size_t MAX_STAGE = 4;
+    // 판별 아이템·게이트 수 히스토그램: 0, 1, 2~3, 4~7, ... (2의 거듭제곱 구간)
+    static constexpr size_t RUN_BUCKETS = 12;
+
+    uint64_t ticks = 0;
+    uint64_t runs = 0;
+    uint64_t deaths[DEATH_REASONS] = {};    // DeathReason별 (NONE은 원인 없이 끝난 판)
+    uint64_t clears = 0;
+    uint64_t abandoned = 0;
+    uint64_t stages[MAX_STAGE + 1] = {};    // 판이 끝난 스테이지 (0은 범위 밖)
+    uint64_t items[ITEM_KINDS] = {};        // ItemKind별 먹은 수
+    uint64_t gates = 0;
+    uint64_t itemsPerRun[RUN_BUCKETS] = {};
+    uint64_t gatesPerRun[RUN_BUCKETS] = {};
+
+    static size_t bucketFor(uint32_t value);
+    // bucket 구간의 가장 작은 값
+    static uint32_t bucketFloor(size_t bucket) { return bucket == 0 ? 0 : 1u << (bucket - 1); }
+};
+
+// 워커 스레드 하나의 통계 샤드
+// - 쓰는 스레드는 소유 워커 하나뿐이므로 카운터는 relaxed load + store로 올림 (lock 접두사 없는 일반 저장)
+// - 읽는 쪽(보고 스레드)은 아무 때나 relaxed load로 읽어 합침 → 합계는 조금 늦을 수 있지만 어느 쪽도 기다리지 않음
+// - 캐시 라인 단위로 정렬해 이웃 샤드와 같은 줄을 쓰지 않음 (false sharing 방지)
+// 워커 하나가 게임 여러 개를 돌리므로 판별 값은 게임마다 StatsRun이 세고, 샤드는 합계만 가짐
+class alignas(64) StatsShard
+{
+public:
+    // --- 소유 워커 스레드 전용 ---
+    void addTicks(uint64_t count) { bump(ticks, count); }
+    void addItem(ItemKind kind) { bump(items[static_cast<size_t>(kind)]); }
+    void addGate() { bump(gates); }
+    // 판이 끝날 때 (stage: 끝난 스테이지, death: DIED일 때의 원인, runItems·runGates: 그 판에서 먹은 아이템·지난 게이트 수)
+    void endRun(int stage, RunEnd end, DeathReason death, uint32_t runItems, uint32_t runGates);
+
+    // --- 아무 스레드 ---
+    void addTo(StatsTotals& totals) const;
+
+private:
+    using Counter = std::atomic<uint64_t>;
+
+    Counter ticks{0};
+    Counter runs{0};
+    Counter deaths[StatsTotals::DEATH_REASONS] = {};
+    Counter clears{0};
+    Counter abandoned{0};
+    Counter stages[StatsTotals::MAX_STAGE + 1] = {};
+    Counter items[StatsTotals::ITEM_KINDS] = {};
+    Counter gates{0};
+    Counter itemsPerRun[StatsTotals::RUN_BUCKETS] = {};
+    Counter gatesPerRun[StatsTotals::RUN_BUCKETS] = {};
+
+    static void bump(Counter& counter, uint64_t count = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+};
+
+// 게임 하나의 진행 중인 판 (소유 워커 전용)
+// Game에 사건 구독자로 붙여 판별 아이템·게이트 수와 사망 원인을 세고, 합계는 샤드로 바로 올림
+class StatsRun : public GameEventSink
+{
+public:
+    explicit StatsRun(StatsShard& shard) : shard(&shard) {}
+
+    void onEvent(const GameEvent& event) override;
+    // 판이 끝날 때 (stage: 끝난 스테이지). 판별 값을 샤드에 넘기고 다음 판을 위해 비움
+    void endRun(int stage, RunEnd end);
+
+private:
+    StatsShard* shard;
+    uint32_t runItems = 0;
+    uint32_t runGates = 0;
+    DeathReason runDeath = DeathReason::NONE;
+};
+
+// 워커 수만큼 샤드를 두고 읽을 때 합침 (전역 잠금 없음)
+class StatsAggregator
+{
+public:
+    explicit StatsAggregator(size_t shardCount);
+
+    StatsAggregator(const StatsAggregator&) = delete;
+    StatsAggregator& operator=(const StatsAggregator&) = delete;
+
+    size_t shardCount() const { return count; }
+    StatsShard& shard(size_t index) { return shards[index]; }
+    StatsTotals collect() const;
+
+private:
+    size_t count;
+    std::unique_ptr<StatsShard[]> shards;
+};
+
+size_t StatsTotals::bucketFor(uint32_t value)
+{
+    size_t bucket = 0;
+    while (value > 0 && bucket + 1 < RUN_BUCKETS) {
+        value >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void StatsShard::endRun(int stage, RunEnd end, DeathReason death, uint32_t runItems, uint32_t runGates)
+{
+    bump(runs);
+    switch (end) {
+        case RunEnd::DIED:      bump(deaths[static_cast<size_t>(death)]); break;
+        case RunEnd::CLEARED:   bump(clears); break;
+        case RunEnd::ABANDONED: bump(abandoned); break;
+    }
+    bump(stages[stage >= 1 && stage <= (int)StatsTotals::MAX_STAGE ? stage : 0]);
+    bump(itemsPerRun[StatsTotals::bucketFor(runItems)]);
+    bump(gatesPerRun[StatsTotals::bucketFor(runGates)]);
+}
+
+void StatsRun::onEvent(const GameEvent& event)
+{
+    switch (event.type) {
+        case EventType::ITEM_CONSUMED:
+            shard->addItem(event.item);
+            runItems++;
+            break;
+        case EventType::GATE_ENTERED:
+            shard->addGate();
+            runGates++;
+            break;
+        case EventType::GAME_OVER:
+            runDeath = event.reason;
+            break;
+        default:
+            break;
+    }
+}
+
+void StatsRun::endRun(int stage, RunEnd end)
+{
+    shard->endRun(stage, end, runDeath, runItems, runGates);
+    runItems = 0;
+    runGates = 0;
+    runDeath = DeathReason::NONE;
+}
+
+void StatsShard::addTo(StatsTotals& totals) const
+{
+    auto read = [](const Counter& counter) { return counter.load(std::memory_order_relaxed); };
+    totals.ticks += read(ticks);
+    totals.runs += read(runs);
+    totals.clears += read(clears);
+    totals.abandoned += read(abandoned);
+    totals.gates += read(gates);
+    for (size_t i = 0; i < StatsTotals::DEATH_REASONS; ++i) totals.deaths[i] += read(deaths[i]);
+    for (size_t i = 0; i <= StatsTotals::MAX_STAGE; ++i) totals.stages[i] += read(stages[i]);
+    for (size_t i = 0; i < StatsTotals::ITEM_KINDS; ++i) totals.items[i] += read(items[i]);
+    for (size_t i = 0; i < StatsTotals::RUN_BUCKETS; ++i) {
+        totals.itemsPerRun[i] += read(itemsPerRun[i]);
+        totals.gatesPerRun[i] += read(gatesPerRun[i]);
+    }
+}
+
+StatsAggregator::StatsAggregator(size_t shardCount)
+    : count(shardCount)
+{
+    if (shardCount == 0) {
+        throw std::invalid_argument("StatsAggregator needs at least one shard");
+    }
+    shards = std::make_unique<StatsShard[]>(shardCount);
+}
+
+StatsTotals StatsAggregator::collect() const
+{
+    StatsTotals totals;
+    for (size_t i = 0; i < count; ++i) shards[i].addTo(totals);
+    return totals;
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "events.h"
+
+using namespace std;
+
+// 텔레메트리 파일 형식 (리틀 엔디언, 추가 전용)
+//   블록을 이어 붙이기만 함. 블록 하나 = 한 표의 행 최대 BLOCK_ROWS개
+//   블록 : "SNKT" | u16 version | u8 table | u8 columnCount | u32 rowCount
+//          | u8 width x columnCount | 열0 값 x rowCount | 열1 값 x rowCount | ...
+//   열마다 값이 연속으로 놓이므로 읽는 쪽은 필요 없는 열을 건너뛸 수 있음 (열 위치 = 앞 열 너비 합 x 행 수)
+//   비정상 종료로 마지막 블록이 잘렸으면 읽는 쪽이 그 블록만 버림
+enum class TelemetryTable : uint8_t {
+    TICKS = 1,  // 틱마다 한 행
+    GAMES = 2   // 한 판(스테이지 시도)이 끝날 때마다 한 행
+};
+
+// 한 판이 끝난 방식
+enum class GameOutcome : uint8_t {
+    GAME_OVER = 1,
+    MISSION_COMPLETE = 2
+};
+
+// 열 순서 (reader와 공유)
+namespace telemetry_columns {
+    // TICKS: session u32 | game u32 | tick u32 | stage u8 | length u16 | latency_ns u32
+    enum TickColumn { TICK_SESSION, TICK_GAME, TICK_INDEX, TICK_STAGE, TICK_LENGTH, TICK_LATENCY, TICK_COLUMNS };
+    const uint8_t TICK_WIDTHS[TICK_COLUMNS] = {4, 4, 4, 1, 2, 4};
+    // GAMES: session u32 | game u32 | stage u8 | outcome u8 | death u8 | ticks u32 | seconds u32
+    //        | length u16 | max_length u16 | growth u16 | poison u16 | time u16 | gates u16
+    enum GameColumn {
+        GAME_SESSION, GAME_ID, GAME_STAGE, GAME_OUTCOME, GAME_DEATH, GAME_TICKS, GAME_SECONDS,
+        GAME_LENGTH, GAME_MAX_LENGTH, GAME_GROWTH, GAME_POISON, GAME_TIME, GAME_GATES, GAME_COLUMNS
+    };
+    const uint8_t GAME_WIDTHS[GAME_COLUMNS] = {4, 4, 1, 1, 1, 4, 4, 2, 2, 2, 2, 2, 2};
+
+    const char MAGIC[4] = {'S', 'N', 'K', 'T'};
+    const uint16_t VERSION = 1;
+    const size_t BLOCK_HEADER_SIZE = 12;
+}
+
+// 열 단위로 값을 쌓는 블록 버퍼 (열마다 BLOCK_ROWS 분량을 생성 시 확보, 쌓는 동안 할당 없음)
+class ColumnBlock
+{
+public:
+    static const size_t MAX_COLUMNS = 32;
+
+    ColumnBlock(TelemetryTable table, const uint8_t* widths, size_t columnCount, size_t capacity);
+
+    // 현재 행의 column 열 값 (너비를 넘는 상위 비트는 잘림)
+    void put(size_t column, uint64_t value);
+    // 현재 행을 확정하고 true면 블록이 가득 참
+    bool endRow() { return ++rows == capacity; }
+    size_t rowCount() const { return rows; }
+    // 쌓인 행을 블록 하나로 fd에 쓰고 비움 (writev 한 번)
+    void writeTo(int fd);
+
+private:
+    TelemetryTable table;
+    std::vector<uint8_t> widths;
+    std::vector<std::vector<uint8_t>> columns;
+    size_t capacity;
+    size_t rows = 0;
+};
+
+// 게임 사건을 구독해 판별 아이템·게이트 수를 세고, Game이 알려주는 틱/판 요약과 함께 열 블록으로 기록
+// 파일은 O_APPEND로 열어 여러 실행 결과가 한 파일에 이어 붙음 (실행마다 세션 번호로 구분)
+class TelemetryWriter : public GameEventSink
+{
+public:
+    static const size_t BLOCK_ROWS = 4096;
+
+    // 파일을 열지 못하면 runtime_error
+    explicit TelemetryWriter(const std::string& path);
+    ~TelemetryWriter();
+
+    TelemetryWriter(const TelemetryWriter&) = delete;
+    TelemetryWriter& operator=(const TelemetryWriter&) = delete;
+
+    // --- 틱 스레드 전용 ---
+    void onEvent(const GameEvent& event) override;
+    // 새 판 시작 (스테이지 시작·재도전). 판별 집계를 비움
+    void beginGame();
+    void recordTick(int stage, int length, std::chrono::nanoseconds latency);
+    void endGame(int stage, GameOutcome outcome, int length, int maxLength, int seconds);
+    // 쌓인 블록을 모두 파일에 씀 (exit() 직전 등)
+    void flush();
+
+    uint32_t session() const { return sessionId; }
+
+private:
+    int fd = -1;
+    uint32_t sessionId;
+    uint32_t gameId = 0;
+    uint32_t gameTicks = 0;
+    uint16_t growthCount = 0, poisonCount = 0, timeCount = 0, gateCount = 0;
+    DeathReason death = DeathReason::NONE;
+    ColumnBlock ticks;
+    ColumnBlock games;
+};
+
+ColumnBlock::ColumnBlock(TelemetryTable table, const uint8_t* widths, size_t columnCount, size_t capacity)
+    : table(table), widths(widths, widths + columnCount), columns(columnCount), capacity(capacity)
+{
+    if (columnCount == 0 || columnCount > MAX_COLUMNS || capacity == 0) {
+        throw std::invalid_argument("Invalid telemetry block layout");
+    }
+    for (size_t c = 0; c < columnCount; ++c) {
+        columns[c].resize(capacity * widths[c]);
+    }
+}
+
+void ColumnBlock::put(size_t column, uint64_t value)
+{
+    uint8_t* p = columns[column].data() + rows * widths[column];
+    for (uint8_t b = 0; b < widths[column]; ++b) {
+        p[b] = (uint8_t)(value >> (8 * b));
+    }
+}
+
+void ColumnBlock::writeTo(int fd)
+{
+    if (rows == 0) return;
+    uint8_t header[telemetry_columns::BLOCK_HEADER_SIZE + MAX_COLUMNS];
+    std::memcpy(header, telemetry_columns::MAGIC, 4);
+    header[4] = (uint8_t)(telemetry_columns::VERSION & 0xFF);
+    header[5] = (uint8_t)(telemetry_columns::VERSION >> 8);
+    header[6] = static_cast<uint8_t>(table);
+    header[7] = (uint8_t)widths.size();
+    for (int b = 0; b < 4; ++b) header[8 + b] = (uint8_t)(rows >> (8 * b));
+    std::memcpy(header + telemetry_columns::BLOCK_HEADER_SIZE, widths.data(), widths.size());
+
+    iovec parts[1 + MAX_COLUMNS];
+    size_t partCount = 0;
+    size_t total = telemetry_columns::BLOCK_HEADER_SIZE + widths.size();
+    parts[partCount++] = {header, total};
+    for (size_t c = 0; c < columns.size(); ++c) {
+        parts[partCount++] = {columns[c].data(), rows * widths[c]};
+        total += rows * widths[c];
+    }
+    rows = 0;
+
+    // O_APPEND이므로 블록 하나가 통째로 파일 끝에 붙음 (짧게 쓰이면 이어서 씀)
+    size_t written = 0;
+    size_t first = 0;
+    while (written < total) {
+        ssize_t n = ::writev(fd, parts + first, (int)(partCount - first));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            throw std::runtime_error(std::string("Failed to write telemetry: ") + std::strerror(errno));
+        }
+        written += (size_t)n;
+        size_t consumed = (size_t)n;
+        while (first < partCount && consumed >= parts[first].iov_len) {
+            consumed -= parts[first].iov_len;
+            first++;
+        }
+        if (first < partCount) {
+            parts[first].iov_base = static_cast<uint8_t*>(parts[first].iov_base) + consumed;
+            parts[first].iov_len -= consumed;
+        }
+    }
+}
+
+TelemetryWriter::TelemetryWriter(const std::string& path)
+    : ticks(TelemetryTable::TICKS, telemetry_columns::TICK_WIDTHS, telemetry_columns::TICK_COLUMNS, BLOCK_ROWS),
+      games(TelemetryTable::GAMES, telemetry_columns::GAME_WIDTHS, telemetry_columns::GAME_COLUMNS, BLOCK_ROWS)
+{
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+    // 세션 번호: 시작 시각과 pid를 섞은 값 (같은 파일에 이어 붙인 실행을 구분하는 용도)
+    uint64_t now = (uint64_t)std::chrono::system_clock::now().time_since_epoch().count();
+    sessionId = (uint32_t)(now ^ (now >> 32) ^ ((uint64_t)::getpid() << 16));
+}
+
+TelemetryWriter::~TelemetryWriter()
+{
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // 소멸자에서는 던지지 않음 (기록 실패는 게임 진행과 무관)
+    }
+    if (fd >= 0) ::close(fd);
+}
+
+void TelemetryWriter::onEvent(const GameEvent& event)
+{
+    switch (event.type) {
+        case EventType::ITEM_CONSUMED:
+            if (event.item == ItemKind::GROWTH) growthCount++;
+            if (event.item == ItemKind::POISON) poisonCount++;
+            if (event.item == ItemKind::TIME) timeCount++;
+            break;
+        case EventType::GATE_ENTERED:
+            gateCount++;
+            break;
+        case EventType::GAME_OVER:
+            death = event.reason;
+            break;
+        default:
+            break;
+    }
+}
+
+void TelemetryWriter::beginGame()
+{
+    gameTicks = 0;
+    growthCount = poisonCount = timeCount = gateCount = 0;
+    death = DeathReason::NONE;
+}
+
+void TelemetryWriter::recordTick(int stage, int length, std::chrono::nanoseconds latency)
+{
+    using namespace telemetry_columns;
+    uint64_t latencyNs = (uint64_t)std::max<int64_t>(0, latency.count());
+    ticks.put(TICK_SESSION, sessionId);
+    ticks.put(TICK_GAME, gameId);
+    ticks.put(TICK_INDEX, gameTicks++);
+    ticks.put(TICK_STAGE, (uint64_t)stage);
+    ticks.put(TICK_LENGTH, (uint64_t)length);
+    ticks.put(TICK_LATENCY, std::min<uint64_t>(latencyNs, UINT32_MAX));
+    if (ticks.endRow()) ticks.writeTo(fd);
+}
+
+void TelemetryWriter::endGame(int stage, GameOutcome outcome, int length, int maxLength, int seconds)
+{
+    using namespace telemetry_columns;
+    games.put(GAME_SESSION, sessionId);
+    games.put(GAME_ID, gameId++);
+    games.put(GAME_STAGE, (uint64_t)stage);
+    games.put(GAME_OUTCOME, static_cast<uint64_t>(outcome));
+    games.put(GAME_DEATH, static_cast<uint64_t>(death));
+    games.put(GAME_TICKS, gameTicks);
+    games.put(GAME_SECONDS, (uint64_t)std::max(0, seconds));
+    games.put(GAME_LENGTH, (uint64_t)length);
+    games.put(GAME_MAX_LENGTH, (uint64_t)maxLength);
+    games.put(GAME_GROWTH, growthCount);
+    games.put(GAME_POISON, poisonCount);
+    games.put(GAME_TIME, timeCount);
+    games.put(GAME_GATES, gateCount);
+    if (games.endRow()) games.writeTo(fd);
+    beginGame();
+}
+
+void TelemetryWriter::flush()
+{
+    ticks.writeTo(fd);
+    games.writeTo(fd);
+}
+
+#endif
@@ -0,0 +1,381 @@
+// 텔레메트리 파일 집계 도구
+// snake --telemetry 로 기록한 열 블록 파일을 블록 단위로 스트리밍하며 요약 (파일 크기와 무관하게 메모리 일정)
+// 틱 표는 세션·지연 열만 읽고 나머지 열은 건너뜀
+//
+//   g++ -std=c++17 -O2 src/telemetry_reader.cpp -o telemetry_reader
+//   ./telemetry_reader run1.telemetry run2.telemetry
+//   ./telemetry_reader --csv games.csv run.telemetry
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "telemetry.h"
+
+// 지연 분포 (2의 거듭제곱 구간을 8칸씩 나눈 로그 히스토그램, 상대 오차 12.5% 이내)
+class LatencyHistogram
+{
+public:
+    void add(uint32_t ns);
+    uint64_t count() const { return total; }
+    uint32_t max() const { return largest; }
+    // q(0~1) 분위수의 구간 상한
+    uint64_t quantile(double q) const;
+
+private:
+    static const int SUB_BITS = 3;
+    static const int BUCKETS = (32 << SUB_BITS) + (1 << SUB_BITS);
+    uint64_t buckets[BUCKETS] = {};
+    uint64_t total = 0;
+    uint32_t largest = 0;
+
+    static int bucketOf(uint32_t ns);
+    static uint64_t upperBound(int bucket);
+};
+
+int LatencyHistogram::bucketOf(uint32_t ns)
+{
+    if (ns < (1u << SUB_BITS)) return (int)ns;
+    int msb = 31 - __builtin_clz(ns);
+    int sub = (int)(ns >> (msb - SUB_BITS)) & ((1 << SUB_BITS) - 1);
+    return ((msb - SUB_BITS + 1) << SUB_BITS) + sub;
+}
+
+uint64_t LatencyHistogram::upperBound(int bucket)
+{
+    if (bucket < (1 << SUB_BITS)) return (uint64_t)bucket;
+    int msb = (bucket >> SUB_BITS) + SUB_BITS - 1;
+    uint64_t sub = (uint64_t)(bucket & ((1 << SUB_BITS) - 1));
+    return (((1ull << SUB_BITS) + sub + 1) << (msb - SUB_BITS)) - 1;
+}
+
+void LatencyHistogram::add(uint32_t ns)
+{
+    buckets[bucketOf(ns)]++;
+    total++;
+    if (ns > largest) largest = ns;
+}
+
+uint64_t LatencyHistogram::quantile(double q) const
+{
+    if (total == 0) return 0;
+    uint64_t rank = (uint64_t)(q * (double)(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return std::min<uint64_t>(upperBound(b), largest);
+    }
+    return largest;
+}
+
+// 스테이지별 판 집계
+struct StageSummary
+{
+    uint64_t games = 0, cleared = 0;
+    uint64_t ticks = 0, seconds = 0;
+    uint64_t maxLengthSum = 0, growth = 0, poison = 0, time = 0, gates = 0;
+    uint16_t bestLength = 0;
+};
+
+struct Summary
+{
+    static const int MAX_STAGE = 8;
+    static const int DEATH_KINDS = 8;
+    uint64_t blocks = 0, truncatedBlocks = 0, skippedBlocks = 0;
+    uint64_t tickRows = 0;
+    uint64_t deaths[DEATH_KINDS] = {};
+    StageSummary stages[MAX_STAGE + 1];     // 0번은 범위를 벗어난 스테이지
+    LatencyHistogram latency;
+    // 틱 표와 판 표 양쪽에서 본 세션 (판이 하나도 끝나지 않은 실행도 셈)
+    std::unordered_set<uint32_t> sessions;
+    uint32_t lastSession = 0;
+
+    // 같은 세션 행이 이어지므로 직전 값과 같으면 해시 조회를 건너뜀
+    void addSession(uint32_t session)
+    {
+        if (!sessions.empty() && session == lastSession) return;
+        sessions.insert(session);
+        lastSession = session;
+    }
+};
+
+uint64_t readLittle(const uint8_t* p, uint8_t width)
+{
+    uint64_t value = 0;
+    for (uint8_t b = 0; b < width; ++b) value |= (uint64_t)p[b] << (8 * b);
+    return value;
+}
+
+// 한 블록의 열들을 필요한 것만 읽어 들임 (필요 없는 열은 fseek로 건너뜀)
+class BlockReader
+{
+public:
+    explicit BlockReader(FILE* file) : file(file) {}
+
+    // 다음 블록 헤더를 읽음. 파일 끝이면 false, 형식이 틀리면 runtime_error
+    bool next();
+    TelemetryTable table() const { return static_cast<TelemetryTable>(tableId); }
+    uint32_t rows() const { return rowCount; }
+    uint8_t width(size_t column) const { return column < widths.size() ? widths[column] : 0; }
+    size_t columnCount() const { return widths.size(); }
+    // column 열을 out에 읽음 (열 순서대로 호출해야 함). 잘렸으면 false
+    bool readColumn(size_t column, std::vector<uint8_t>& out);
+    // 이 블록의 나머지 열을 건너뜀. 잘렸으면 false
+    bool finish();
+
+private:
+    FILE* file;
+    uint8_t tableId = 0;
+    uint32_t rowCount = 0;
+    std::vector<uint8_t> widths;
+    size_t nextColumn = 0;
+    long payloadStart = 0;
+
+    long columnOffset(size_t column) const;
+    bool seekTo(long offset);
+};
+
+bool BlockReader::next()
+{
+    uint8_t header[telemetry_columns::BLOCK_HEADER_SIZE];
+    size_t n = std::fread(header, 1, sizeof(header), file);
+    if (n == 0) return false;
+    if (n < sizeof(header)) throw std::length_error("Truncated block header");
+    if (std::memcmp(header, telemetry_columns::MAGIC, 4) != 0) {
+        throw std::runtime_error("Not a telemetry block");
+    }
+    if ((uint16_t)readLittle(header + 4, 2) != telemetry_columns::VERSION) {
+        throw std::runtime_error("Unsupported telemetry version");
+    }
+    tableId = header[6];
+    widths.resize(header[7]);
+    rowCount = (uint32_t)readLittle(header + 8, 4);
+    if (!widths.empty() && std::fread(widths.data(), 1, widths.size(), file) != widths.size()) {
+        throw std::length_error("Truncated block header");
+    }
+    payloadStart = std::ftell(file);
+    nextColumn = 0;
+    return true;
+}
+
+long BlockReader::columnOffset(size_t column) const
+{
+    long offset = payloadStart;
+    for (size_t c = 0; c < column; ++c) offset += (long)widths[c] * rowCount;
+    return offset;
+}
+
+bool BlockReader::seekTo(long offset)
+{
+    return std::fseek(file, offset, SEEK_SET) == 0;
+}
+
+bool BlockReader::readColumn(size_t column, std::vector<uint8_t>& out)
+{
+    if (column >= widths.size()) return false;
+    if (column != nextColumn && !seekTo(columnOffset(column))) return false;
+    out.resize((size_t)widths[column] * rowCount);
+    nextColumn = column + 1;
+    return std::fread(out.data(), 1, out.size(), file) == out.size();
+}
+
+bool BlockReader::finish()
+{
+    long end = columnOffset(widths.size());
+    if (!seekTo(end)) return false;
+    // fseek는 파일 끝을 넘어도 성공하므로 실제 크기로 잘림 여부 확인
+    int c = std::fgetc(file);
+    if (c == EOF) {
+        std::fseek(file, 0, SEEK_END);
+        return std::ftell(file) >= end;
+    }
+    std::ungetc(c, file);
+    return true;
+}
+
+// 판 표 블록 하나를 집계에 더함 (csv가 있으면 행마다 한 줄 출력)
+void addGames(BlockReader& block, Summary& summary, std::vector<uint8_t> (&columns)[telemetry_columns::GAME_COLUMNS], FILE* csv)
+{
+    using namespace telemetry_columns;
+    auto value = [&](int column, uint32_t row) {
+        return readLittle(columns[column].data() + (size_t)row * block.width(column), block.width(column));
+    };
+    for (uint32_t row = 0; row < block.rows(); ++row) {
+        uint32_t session = (uint32_t)value(GAME_SESSION, row);
+        summary.addSession(session);
+        int stage = (int)value(GAME_STAGE, row);
+        StageSummary& s = summary.stages[stage >= 1 && stage <= Summary::MAX_STAGE ? stage : 0];
+        bool cleared = value(GAME_OUTCOME, row) == static_cast<uint64_t>(GameOutcome::MISSION_COMPLETE);
+        uint64_t death = value(GAME_DEATH, row);
+        uint16_t maxLength = (uint16_t)value(GAME_MAX_LENGTH, row);
+        s.games++;
+        if (cleared) s.cleared++;
+        else summary.deaths[death < Summary::DEATH_KINDS ? death : 0]++;
+        s.ticks += value(GAME_TICKS, row);
+        s.seconds += value(GAME_SECONDS, row);
+        s.maxLengthSum += maxLength;
+        if (maxLength > s.bestLength) s.bestLength = maxLength;
+        s.growth += value(GAME_GROWTH, row);
+        s.poison += value(GAME_POISON, row);
+        s.time += value(GAME_TIME, row);
+        s.gates += value(GAME_GATES, row);
+        if (csv) {
+            std::fprintf(csv, "%u,%llu,%d,%s,%llu,%llu,%llu,%llu,%u,%llu,%llu,%llu,%llu\n",
+                         session, (unsigned long long)value(GAME_ID, row), stage,
+                         cleared ? "clear" : "game_over", (unsigned long long)death,
+                         (unsigned long long)value(GAME_TICKS, row), (unsigned long long)value(GAME_SECONDS, row),
+                         (unsigned long long)value(GAME_LENGTH, row), maxLength,
+                         (unsigned long long)value(GAME_GROWTH, row), (unsigned long long)value(GAME_POISON, row),
+                         (unsigned long long)value(GAME_TIME, row), (unsigned long long)value(GAME_GATES, row));
+        }
+    }
+}
+
+// 파일 하나를 끝까지 읽어 집계. 잘린 마지막 블록은 버리고 경고만 남김
+void readFile(const std::string& path, Summary& summary, FILE* csv)
+{
+    using namespace telemetry_columns;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        throw std::runtime_error("Failed to open " + path + ": " + std::strerror(errno));
+    }
+    BlockReader block(file);
+    std::vector<uint8_t> sessions, latency;
+    std::vector<uint8_t> gameColumns[GAME_COLUMNS];
+    try {
+        while (block.next()) {
+            bool complete = true;
+            if (block.table() == TelemetryTable::TICKS && block.columnCount() == TICK_COLUMNS) {
+                complete = block.readColumn(TICK_SESSION, sessions) && block.readColumn(TICK_LATENCY, latency);
+                if (complete) {
+                    uint8_t sessionWidth = block.width(TICK_SESSION);
+                    uint8_t width = block.width(TICK_LATENCY);
+                    for (uint32_t row = 0; row < block.rows(); ++row) {
+                        summary.addSession((uint32_t)readLittle(sessions.data() + (size_t)row * sessionWidth, sessionWidth));
+                        summary.latency.add((uint32_t)readLittle(latency.data() + (size_t)row * width, width));
+                    }
+                    summary.tickRows += block.rows();
+                }
+            } else if (block.table() == TelemetryTable::GAMES && block.columnCount() == GAME_COLUMNS) {
+                for (size_t c = 0; c < GAME_COLUMNS && complete; ++c) {
+                    complete = block.readColumn(c, gameColumns[c]);
+                }
+                if (complete) addGames(block, summary, gameColumns, csv);
+            } else {
+                // 모르는 표나 열 구성이 다른 블록은 건너뜀
+                summary.skippedBlocks++;
+            }
+            if (!complete || !block.finish()) {
+                summary.truncatedBlocks++;
+                break;
+            }
+            summary.blocks++;
+        }
+    } catch (const std::length_error&) {
+        summary.truncatedBlocks++;
+    } catch (...) {
+        std::fclose(file);
+        throw;
+    }
+    std::fclose(file);
+}
+
+void printSummary(const Summary& summary)
+{
+    static const char* deathNames[] = {"unknown", "opposite direction", "wall", "body in wall", "self", "too short"};
+    StageSummary all;
+    for (const StageSummary& s : summary.stages) {
+        all.games += s.games;
+        all.cleared += s.cleared;
+        all.ticks += s.ticks;
+    }
+
+    std::printf("blocks %llu (truncated %llu, skipped %llu), sessions %zu\n",
+                (unsigned long long)summary.blocks, (unsigned long long)summary.truncatedBlocks,
+                (unsigned long long)summary.skippedBlocks, summary.sessions.size());
+    std::printf("games %llu, cleared %llu (%.1f%%), ticks in games %llu\n",
+                (unsigned long long)all.games, (unsigned long long)all.cleared,
+                all.games ? 100.0 * all.cleared / all.games : 0.0, (unsigned long long)all.ticks);
+
+    std::printf("\nstage  games    clear%%  avg ticks  avg secs  avg max len  best  avg +    avg -    avg T    avg G\n");
+    for (int stage = 0; stage <= Summary::MAX_STAGE; ++stage) {
+        const StageSummary& s = summary.stages[stage];
+        if (s.games == 0) continue;
+        double n = (double)s.games;
+        std::printf("%-5s  %-7llu  %6.1f  %9.1f  %8.1f  %11.2f  %4u  %-7.2f  %-7.2f  %-7.2f  %-7.2f\n",
+                    stage == 0 ? "other" : std::to_string(stage).c_str(), (unsigned long long)s.games,
+                    100.0 * s.cleared / n, s.ticks / n, s.seconds / n, s.maxLengthSum / n, s.bestLength,
+                    s.growth / n, s.poison / n, s.time / n, s.gates / n);
+    }
+
+    std::printf("\ndeath reasons\n");
+    for (int d = 0; d < Summary::DEATH_KINDS; ++d) {
+        if (summary.deaths[d] == 0) continue;
+        const char* name = d < (int)(sizeof(deathNames) / sizeof(deathNames[0])) ? deathNames[d] : "unknown";
+        std::printf("  %-20s %llu\n", name, (unsigned long long)summary.deaths[d]);
+    }
+
+    const LatencyHistogram& latency = summary.latency;
+    std::printf("\ntick latency (%llu ticks)\n", (unsigned long long)latency.count());
+    if (latency.count() > 0) {
+        std::printf("  p50 %.2f us  p90 %.2f us  p99 %.2f us  p99.9 %.2f us  max %.2f us\n",
+                    latency.quantile(0.5) / 1000.0, latency.quantile(0.9) / 1000.0,
+                    latency.quantile(0.99) / 1000.0, latency.quantile(0.999) / 1000.0,
+                    latency.max() / 1000.0);
+    }
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--csv FILE] TELEMETRY..." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> paths;
+    std::string csvPath;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else if (argv[i][0] == '-') {
+            printUsage(argv[0]);
+            return 2;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    FILE* csv = nullptr;
+    if (!csvPath.empty()) {
+        csv = std::fopen(csvPath.c_str(), "w");
+        if (!csv) {
+            std::cerr << "Failed to open " << csvPath << ": " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+        std::fprintf(csv, "session,game,stage,outcome,death,ticks,seconds,length,max_length,growth,poison,time,gates\n");
+    }
+
+    int status = 0;
+    Summary summary;
+    for (const std::string& path : paths) {
+        try {
+            readFile(path, summary, csv);
+        } catch (const std::exception& e) {
+            std::cerr << path << ": " << e.what() << std::endl;
+            status = 1;
+        }
+    }
+    if (csv) std::fclose(csv);
+    if (summary.truncatedBlocks > 0) {
+        std::cerr << "warning: ignored " << summary.truncatedBlocks << " truncated block(s)" << std::endl;
+    }
+    printSummary(summary);
+    return status;
+}
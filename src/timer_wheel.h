@@ -0,0 +1,263 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// 계층형 타이머 휠 (틱 단위)
+// - 4단계 x 64칸: 0단계는 1틱, 1단계는 64틱, 2단계는 4096틱 ... 단위로 묶음
+// - advance() 한 번의 비용은 이번 틱에 만료된 타이머 수 + (64틱마다) 윗단계 한 칸 재배치
+//   → 등록된 타이머 수와 무관
+// - 노드는 풀에서 재사용 (워밍업 이후 schedule/cancel에 할당 없음), cancel은 O(1)
+class TimerWheel
+{
+public:
+    // 0은 "없음". 하위 20비트는 노드 번호+1, 상위 12비트는 재사용 세대 (오래된 id로 cancel해도 안전)
+    using TimerId = uint32_t;
+    static constexpr TimerId NO_TIMER = 0;
+
+    // 노드 풀은 resource에서 받음
+    explicit TimerWheel(size_t initialCapacity = 64,
+                        std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // delay틱 뒤(delay번째 advance)에 만료. delay는 1 이상
+    TimerId schedule(uint32_t delay, uint16_t tag, uint32_t data = 0);
+    // 대기 중이면 취소하고 true. id는 NO_TIMER로 바뀜
+    bool cancel(TimerId& id);
+    bool pending(TimerId id) const;
+    // 남은 틱 (없으면 0)
+    uint64_t remaining(TimerId id) const;
+
+    // 한 틱 진행하고 만료된 타이머마다 onExpire(tag, data) 호출
+    // 콜백 안에서 schedule/cancel 해도 됨
+    template <typename Callback>
+    void advance(Callback&& onExpire);
+
+    // 모든 타이머 취소 (현재 시각은 유지)
+    void clear();
+    // 모든 타이머 취소하고 시각도 0으로 (새로 만든 휠과 같은 순서로 만료됨)
+    void reset();
+
+    uint64_t now() const { return currentTick; }
+    size_t size() const { return activeCount; }
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const uint32_t SLOTS = 1u << SLOT_BITS;
+    static const uint32_t NIL = UINT32_MAX;
+    static const uint8_t FREE = 0xFF;       // 풀에 반납된 노드
+    static const uint8_t FIRING = 0xFE;     // 이번 틱 만료 목록에 있는 노드
+    static const uint32_t INDEX_BITS = 20;
+    static const uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+
+    struct Node
+    {
+        uint64_t expiry = 0;
+        uint32_t prev = NIL, next = NIL;
+        uint32_t data = 0;
+        uint16_t tag = 0;
+        uint16_t generation = 0;
+        uint8_t level = FREE;
+        uint8_t slot = 0;
+    };
+
+    std::pmr::vector<Node> nodes;
+    uint32_t freeHead = NIL;
+    uint32_t slots[LEVELS][SLOTS];
+    uint32_t firingHead = NIL;
+    uint64_t currentTick = 0;
+    size_t activeCount = 0;
+
+    uint32_t allocate();
+    void release(uint32_t index);
+    void insert(uint32_t index);
+    void unlink(uint32_t index);
+    void cascade(int level);
+    uint32_t indexOf(TimerId id) const;
+    TimerId idOf(uint32_t index) const
+    {
+        return ((uint32_t)(nodes[index].generation & 0xFFF) << INDEX_BITS) | (index + 1);
+    }
+};
+
+TimerWheel::TimerWheel(size_t initialCapacity, std::pmr::memory_resource* resource)
+    : nodes(resource)
+{
+    for (auto& level : slots) {
+        for (auto& head : level) head = NIL;
+    }
+    nodes.reserve(initialCapacity);
+}
+
+uint32_t TimerWheel::allocate()
+{
+    if (freeHead != NIL) {
+        uint32_t index = freeHead;
+        freeHead = nodes[index].next;
+        return index;
+    }
+    if (nodes.size() >= INDEX_MASK) {
+        throw std::length_error("Too many timers");
+    }
+    nodes.emplace_back();
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void TimerWheel::release(uint32_t index)
+{
+    Node& node = nodes[index];
+    node.level = FREE;
+    node.generation++;
+    node.prev = NIL;
+    node.next = freeHead;
+    freeHead = index;
+    activeCount--;
+}
+
+void TimerWheel::insert(uint32_t index)
+{
+    Node& node = nodes[index];
+    uint64_t delta = node.expiry - currentTick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= ((uint64_t)SLOTS << (SLOT_BITS * level))) {
+        level++;
+    }
+    uint32_t slot = (uint32_t)(node.expiry >> (SLOT_BITS * level)) & (SLOTS - 1);
+    node.level = static_cast<uint8_t>(level);
+    node.slot = static_cast<uint8_t>(slot);
+    node.prev = NIL;
+    node.next = slots[level][slot];
+    if (node.next != NIL) nodes[node.next].prev = index;
+    slots[level][slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index)
+{
+    Node& node = nodes[index];
+    if (node.prev != NIL) {
+        nodes[node.prev].next = node.next;
+    } else if (node.level == FIRING) {
+        firingHead = node.next;
+    } else {
+        slots[node.level][node.slot] = node.next;
+    }
+    if (node.next != NIL) nodes[node.next].prev = node.prev;
+    node.prev = node.next = NIL;
+}
+
+uint32_t TimerWheel::indexOf(TimerId id) const
+{
+    if (id == NO_TIMER) return NIL;
+    uint32_t index = (id & INDEX_MASK) - 1;
+    if (index >= nodes.size()) return NIL;
+    const Node& node = nodes[index];
+    if (node.level == FREE || (node.generation & 0xFFF) != (id >> INDEX_BITS)) return NIL;
+    return index;
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint32_t delay, uint16_t tag, uint32_t data)
+{
+    if (delay == 0) delay = 1;
+    uint32_t index = allocate();
+    Node& node = nodes[index];
+    node.expiry = currentTick + delay;
+    node.tag = tag;
+    node.data = data;
+    insert(index);
+    activeCount++;
+    return idOf(index);
+}
+
+bool TimerWheel::cancel(TimerId& id)
+{
+    uint32_t index = indexOf(id);
+    id = NO_TIMER;
+    if (index == NIL) return false;
+    unlink(index);
+    release(index);
+    return true;
+}
+
+bool TimerWheel::pending(TimerId id) const
+{
+    return indexOf(id) != NIL;
+}
+
+uint64_t TimerWheel::remaining(TimerId id) const
+{
+    uint32_t index = indexOf(id);
+    return index == NIL ? 0 : nodes[index].expiry - currentTick;
+}
+
+void TimerWheel::cascade(int level)
+{
+    // 윗단계 한 칸의 타이머를 남은 시간에 맞는 아랫단계로 다시 배치
+    uint32_t slot = (uint32_t)(currentTick >> (SLOT_BITS * level)) & (SLOTS - 1);
+    uint32_t index = slots[level][slot];
+    slots[level][slot] = NIL;
+    while (index != NIL) {
+        uint32_t next = nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+template <typename Callback>
+void TimerWheel::advance(Callback&& onExpire)
+{
+    currentTick++;
+    // 윗단계 칸 경계를 지날 때만 재배치
+    for (int level = 1; level < LEVELS; ++level) {
+        if (currentTick & ((1ull << (SLOT_BITS * level)) - 1)) break;
+        cascade(level);
+    }
+
+    // 이번 칸을 만료 목록으로 떼어낸 뒤 하나씩 처리
+    // (콜백이 새로 등록한 타이머가 같은 칸에 들어가도 이번 틱에 실행되지 않음)
+    uint32_t slot = (uint32_t)currentTick & (SLOTS - 1);
+    firingHead = slots[0][slot];
+    slots[0][slot] = NIL;
+    for (uint32_t index = firingHead; index != NIL; index = nodes[index].next) {
+        nodes[index].level = FIRING;
+    }
+    while (firingHead != NIL) {
+        uint32_t index = firingHead;
+        unlink(index);
+        uint16_t tag = nodes[index].tag;
+        uint32_t data = nodes[index].data;
+        release(index);
+        onExpire(tag, data);
+    }
+}
+
+void TimerWheel::clear()
+{
+    for (auto& level : slots) {
+        for (auto& head : level) {
+            while (head != NIL) {
+                uint32_t index = head;
+                unlink(index);
+                release(index);
+            }
+        }
+    }
+    while (firingHead != NIL) {
+        uint32_t index = firingHead;
+        unlink(index);
+        release(index);
+    }
+}
+
+void TimerWheel::reset()
+{
+    clear();
+    currentTick = 0;
+}
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef UILOOP_H
+#define UILOOP_H
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <ncurses.h>
+#include "input.h"
+
+using namespace std;
+
+// 대화형 화면(메뉴·게임·모달 창)용 C++20 코루틴
+// - UiTask<T>: 지연 시작 코루틴. co_await하면 끝날 때까지 기다렸다가 결과(또는 예외)를 받음
+// - UiLoop  : 코루틴을 깨우는 단일 이벤트 루프. 키 입력(입력 스레드 eventfd)과 타이머를 한 번의 poll로 기다림
+// 화면마다 따로 돌던 대기 루프 대신 모두 이 루프 위에서 co_await로 양보 (다음 스테이지 준비는 Game의 작업 스레드가 맡음)
+template <typename T = void>
+class UiTask;
+
+namespace ui_detail {
+
+// 코루틴이 끝나면 기다리던 쪽을 바로 이어서 실행 (symmetric transfer, 스택이 쌓이지 않음)
+struct FinalAwaiter
+{
+    bool await_ready() noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+    {
+        std::coroutine_handle<> continuation = handle.promise().continuation;
+        return continuation ? continuation : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+};
+
+struct PromiseBase
+{
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+    void rethrowIfFailed()
+    {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+template <typename T>
+struct Promise : PromiseBase
+{
+    std::optional<T> value;
+
+    void return_value(T result) { value = std::move(result); }
+    T take()
+    {
+        rethrowIfFailed();
+        return std::move(*value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase
+{
+    void return_void() {}
+    void take() { rethrowIfFailed(); }
+};
+
+} // namespace ui_detail
+
+template <typename T>
+class UiTask
+{
+public:
+    struct promise_type : ui_detail::Promise<T>
+    {
+        UiTask get_return_object() { return UiTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    UiTask(UiTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    UiTask& operator=(UiTask&& other) noexcept
+    {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    ~UiTask()
+    {
+        if (handle) handle.destroy();
+    }
+
+    UiTask(const UiTask&) = delete;
+    UiTask& operator=(const UiTask&) = delete;
+
+    bool done() const { return !handle || handle.done(); }
+
+    // co_await: 이 코루틴을 시작하고, 끝나면 기다린 쪽을 재개
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+    T await_resume() { return handle.promise().take(); }
+
+private:
+    friend class UiLoop;
+    Handle handle;
+
+    explicit UiTask(Handle handle) : handle(handle) {}
+};
+
+class UiLoop
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit UiLoop(InputThread& input) : input(input) {}
+
+    UiLoop(const UiLoop&) = delete;
+    UiLoop& operator=(const UiLoop&) = delete;
+
+    // task를 끝날 때까지 진행하고 결과를 돌려줌
+    template <typename T>
+    T run(UiTask<T> task);
+
+    // --- co_await 대상 ---
+    struct KeyAwaiter
+    {
+        UiLoop& loop;
+        int key = ERR;
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> handle);
+        int await_resume() { return key != ERR ? key : std::exchange(loop.deliveredKey, ERR); }
+    };
+    struct SleepAwaiter
+    {
+        UiLoop& loop;
+        Clock::time_point when;
+
+        bool await_ready() const { return Clock::now() >= when; }
+        void await_suspend(std::coroutine_handle<> handle) { loop.timers.push_back(Timer{when, handle}); }
+        void await_resume() const noexcept {}
+    };
+
+    // 키가 올 때까지 대기 (한 번에 한 코루틴만)
+    KeyAwaiter nextKey() { return KeyAwaiter{*this}; }
+    // 지정 시각까지 대기
+    SleepAwaiter sleepUntil(Clock::time_point when) { return SleepAwaiter{*this, when}; }
+    SleepAwaiter sleepFor(Clock::duration delay) { return sleepUntil(Clock::now() + delay); }
+
+private:
+    struct Timer
+    {
+        Clock::time_point when;
+        std::coroutine_handle<> handle;
+    };
+
+    InputThread& input;
+    std::deque<std::coroutine_handle<>> ready;
+    std::vector<Timer> timers;
+    std::coroutine_handle<> keyWaiter;
+    int deliveredKey = ERR;
+
+    // 준비된 코루틴 하나를 돌리거나, 없으면 키·타이머를 기다림
+    void step();
+};
+
+template <typename T>
+T UiLoop::run(UiTask<T> task)
+{
+    ready.push_back(task.handle);
+    while (!task.done()) {
+        step();
+    }
+    return task.handle.promise().take();
+}
+
+bool UiLoop::KeyAwaiter::await_ready()
+{
+    key = loop.input.readKey();
+    return key != ERR;
+}
+
+void UiLoop::KeyAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    if (loop.keyWaiter) {
+        throw std::logic_error("Only one coroutine may wait for a key");
+    }
+    loop.keyWaiter = handle;
+}
+
+void UiLoop::step()
+{
+    if (!ready.empty()) {
+        std::coroutine_handle<> handle = ready.front();
+        ready.pop_front();
+        handle.resume();
+        return;
+    }
+
+    // 가장 이른 타이머
+    size_t earliest = timers.size();
+    for (size_t i = 0; i < timers.size(); ++i) {
+        if (earliest == timers.size() || timers[i].when < timers[earliest].when) earliest = i;
+    }
+    if (earliest == timers.size() && !keyWaiter) {
+        throw std::logic_error("UI loop has nothing to wait for");
+    }
+
+    if (keyWaiter) {
+        // 키를 기다리는 코루틴이 있으면 eventfd를 poll (타이머가 있으면 그때까지만)
+        int timeoutMs = -1;
+        if (earliest < timers.size()) {
+            auto remaining = timers[earliest].when - Clock::now();
+            timeoutMs = (int)std::max<long long>(0, std::chrono::ceil<std::chrono::milliseconds>(remaining).count());
+        }
+        input.waitReady(timeoutMs);
+        int key = input.readKey();
+        if (key != ERR) {
+            deliveredKey = key;
+            ready.push_back(std::exchange(keyWaiter, {}));
+        }
+    } else {
+        std::this_thread::sleep_until(timers[earliest].when);
+    }
+
+    // 시각이 된 타이머를 모두 준비 목록으로
+    Clock::time_point now = Clock::now();
+    for (size_t i = 0; i < timers.size();) {
+        if (timers[i].when <= now) {
+            ready.push_back(timers[i].handle);
+            timers[i] = timers.back();
+            timers.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef VIEWPORT_H
+#define VIEWPORT_H
+
+#include <algorithm>
+#include "block.h"
+
+using namespace std;
+
+// 보드 화면에 보이는 맵 영역 (카메라)
+// - 맵(테두리 안쪽)이 터미널에 다 들어가면 맵 전체, 아니면 터미널에 맞춘 크기만 보여 줌
+// - 머리가 가장자리 여백(보이는 크기의 1/4) 안으로 들어오면 그만큼 스크롤해 머리를 따라감
+// - 좌표는 점유 격자 기준 (1행/1열이 맵 첫 칸, 0행/0열은 바깥 테두리)
+// 보드 창 = 보이는 칸 + 상자 테두리 한 줄씩, 오른쪽에 점수판·미션판
+// 스크롤해야 하는 맵이고 터미널 폭이 되면 그 오른쪽에 미니맵 판도 둠 (보드 폭을 그만큼 줄임)
+class Viewport
+{
+public:
+    // 점수판·미션판 자리 (보드 창 오른쪽 여백 2 + 판 너비 27 + 여유 4)
+    static constexpr int SIDE_PANEL_COLUMNS = 33;
+    // 미니맵 판 자리 (점수판 오른쪽 여백 1 + 판 너비 27)
+    static constexpr int MINIMAP_COLUMNS = 28;
+    static constexpr int MINIMAP_WIDTH = 27;
+    static constexpr int MINIMAP_HEIGHT = 19;
+    // 보드 창 아래 여유 줄
+    static constexpr int BOTTOM_MARGIN = 3;
+    // 맵이 이보다 크면 적어도 이만큼은 보여야 함 (터미널 최소 크기 계산용)
+    static constexpr int MIN_ROWS = 15;
+    static constexpr int MIN_COLS = 21;
+
+    Viewport() = default;
+    // mapHeight x mapWidth 맵을 termRows x termCols 터미널에 보여줄 때
+    Viewport(int mapHeight, int mapWidth, int termRows, int termCols);
+
+    // 이 맵을 그리는 데 필요한 최소 터미널 크기
+    static int requiredRows(int mapHeight) { return std::min(mapHeight, MIN_ROWS) + 2 + BOTTOM_MARGIN; }
+    static int requiredCols(int mapWidth) { return std::min(mapWidth, MIN_COLS) + 2 + SIDE_PANEL_COLUMNS; }
+
+    int rows() const { return viewRows; }
+    int cols() const { return viewCols; }
+    int top() const { return originRow; }
+    int left() const { return originCol; }
+    // 보드 창(테두리 포함) 오른쪽에서 판을 놓을 열
+    int panelColumn() const { return viewCols + 4; }
+    bool scrolls() const { return viewRows < mapRows || viewCols < mapCols; }
+    bool showsMinimap() const { return minimap; }
+    int minimapColumn() const { return panelColumn() + MINIMAP_COLUMNS; }
+
+    // 머리가 여백 안으로 들어왔으면 스크롤 (여백 밖이면 그대로)
+    void follow(const Coord& head);
+    // 머리를 가운데에 (스테이지 시작 시)
+    void center(const Coord& head);
+
+private:
+    int mapRows = 0, mapCols = 0;
+    int viewRows = 0, viewCols = 0;
+    int originRow = 1, originCol = 1;
+    bool minimap = false;
+
+    static int scrollAxis(int origin, int head, int view, int map);
+    void clamp();
+};
+
+Viewport::Viewport(int mapHeight, int mapWidth, int termRows, int termCols)
+    : mapRows(mapHeight), mapCols(mapWidth)
+{
+    viewRows = std::max(1, std::min(mapHeight, termRows - 2 - BOTTOM_MARGIN));
+    viewCols = std::max(1, std::min(mapWidth, termCols - 2 - SIDE_PANEL_COLUMNS));
+    // 미니맵 자리를 빼고도 보드가 최소 폭 이상이면 미니맵 표시
+    int narrowed = termCols - 2 - SIDE_PANEL_COLUMNS - MINIMAP_COLUMNS;
+    if (scrolls() && narrowed >= std::min(mapWidth, MIN_COLS) && termRows >= MINIMAP_HEIGHT) {
+        minimap = true;
+        viewCols = std::max(1, std::min(mapWidth, narrowed));
+    }
+}
+
+int Viewport::scrollAxis(int origin, int head, int view, int map)
+{
+    if (view >= map) return 1;
+    int margin = view / 4;
+    // 보이는 범위: origin ~ origin + view - 1
+    if (head < origin + margin) origin = head - margin;
+    if (head > origin + view - 1 - margin) origin = head - (view - 1 - margin);
+    return std::max(1, std::min(origin, map - view + 1));
+}
+
+void Viewport::follow(const Coord& head)
+{
+    originRow = scrollAxis(originRow, head.row, viewRows, mapRows);
+    originCol = scrollAxis(originCol, head.col, viewCols, mapCols);
+}
+
+void Viewport::center(const Coord& head)
+{
+    originRow = head.row - viewRows / 2;
+    originCol = head.col - viewCols / 2;
+    clamp();
+}
+
+void Viewport::clamp()
+{
+    originRow = std::max(1, std::min(originRow, mapRows - viewRows + 1));
+    originCol = std::max(1, std::min(originCol, mapCols - viewCols + 1));
+}
+
+#endif
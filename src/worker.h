@@ -0,0 +1,107 @@
+#ifndef WORKER_H
+#define WORKER_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+#include "game.h"
+
+using namespace std;
+
+// 배치 워커 스레드용 배치(placement) 도구
+// 워커는 먼저 코어에 고정한 뒤 자기 메모리를 확보함 → 리눅스 first-touch 정책에 따라 페이지가 그 코어의 NUMA 노드에 놓임
+// (libnuma 없이 동작. 단일 소켓 머신에서는 캐시 지역성만 얻음)
+
+// 호출한 스레드를 프로세스가 쓸 수 있는 CPU 중 index번째(나머지 순환)에 고정. 실패하면 false
+inline bool pinCurrentThread(size_t index)
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+    int available = CPU_COUNT(&allowed);
+    if (available <= 0) return false;
+    size_t target = index % (size_t)available;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) continue;
+        if (target-- == 0) {
+            cpu_set_t one;
+            CPU_ZERO(&one);
+            CPU_SET(cpu, &one);
+            return pthread_setaffinity_np(pthread_self(), sizeof(one), &one) == 0;
+        }
+    }
+    return false;
+}
+
+// 워커 하나가 맡는 게임 count개
+// - Game 객체들을 워커 메모리의 한 블록에 STRIDE 간격으로 놓음 (sizeof(Game)을 캐시 라인 배수로 올린 값이라
+//   모든 게임이 캐시 라인 경계에서 시작하고, 이웃 게임과 캐시 라인을 나눠 쓰지 않음)
+// - 각 게임이 따로 할당하는 것(아레나 청크, 연결 요소·빈 칸·미니맵 색인, 타이머 노드, 미션 배열)도
+//   같은 메모리에서 받음 (GameOptions::memory)
+// 게임 i의 시드는 base.seed + i. 소멸은 생성 역순
+class GameBlock
+{
+public:
+    GameBlock(size_t count, const GameOptions& base, std::pmr::memory_resource* memory);
+    ~GameBlock();
+
+    GameBlock(const GameBlock&) = delete;
+    GameBlock& operator=(const GameBlock&) = delete;
+
+    size_t size() const { return constructed; }
+    Game& operator[](size_t index) { return *at(index); }
+
+private:
+    static constexpr size_t ALIGNMENT = 64;
+    static constexpr size_t STRIDE = (sizeof(Game) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    static_assert(alignof(Game) <= ALIGNMENT, "Game must fit the block alignment");
+
+    std::pmr::memory_resource* memory;
+    size_t capacity;
+    size_t constructed = 0;
+    std::byte* storage;
+
+    Game* at(size_t index) { return std::launder(reinterpret_cast<Game*>(storage + index * STRIDE)); }
+    void destroy();
+};
+
+GameBlock::GameBlock(size_t count, const GameOptions& base, std::pmr::memory_resource* memory)
+    : memory(memory), capacity(count)
+{
+    if (count == 0) {
+        throw std::invalid_argument("GameBlock needs at least one game");
+    }
+    storage = static_cast<std::byte*>(memory->allocate(STRIDE * count, ALIGNMENT));
+    try {
+        for (; constructed < count; ++constructed) {
+            GameOptions options = base;
+            options.seed = base.seed + static_cast<unsigned int>(constructed);
+            options.memory = memory;
+            new (storage + constructed * STRIDE) Game(options);
+        }
+    } catch (...) {
+        destroy();
+        throw;
+    }
+}
+
+GameBlock::~GameBlock()
+{
+    destroy();
+}
+
+void GameBlock::destroy()
+{
+    while (constructed > 0) {
+        at(--constructed)->~Game();
+    }
+    if (storage) {
+        memory->deallocate(storage, STRIDE * capacity, ALIGNMENT);
+        storage = nullptr;
+    }
+}
+
+#endif